@@ -0,0 +1,103 @@
+#pragma once
+
+#include <wolv/container/interval_tree.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace wolv::container {
+
+    /**
+     * @brief Interval tree that can be read from many threads while it's being updated
+     * @details Readers grab an immutable snapshot of the tree and query it without any further synchronization.
+     *          Grabbing the snapshot itself isn't lock free: the standard library guards the shared pointer with a short
+     *          internal lock while its reference count gets incremented, which readers and the publishing writer briefly
+     *          contend on. Writers apply their changes to a private copy of the current tree and publish it once they're
+     *          done, so readers never observe a half updated tree and never wait for a writer to finish its changes.
+     *          Copying a tree shares its immutable index runs, so publishing only duplicates the value storage
+     * @tparam Type The value type to be stored
+     * @tparam Scalar The scalar type to be used for the interval start and end values
+     * @tparam SearchRange The maximum range to search backwards to look for intervals that encompass other intervals
+     */
+    template<typename Type, std::integral Scalar = u64, i64 SearchRange = std::numeric_limits<i64>::max()>
+    class ConcurrentIntervalTree {
+    public:
+        using Tree = IntervalTree<Type, Scalar, SearchRange>;
+        using Snapshot = std::shared_ptr<const Tree>;
+
+        ConcurrentIntervalTree() : m_current(std::make_shared<const Tree>()) { }
+
+        /**
+         * @brief Creates a concurrent tree that initially publishes the given tree
+         * @param tree Tree to publish
+         */
+        explicit ConcurrentIntervalTree(Tree tree) : m_current(std::make_shared<const Tree>(std::move(tree))) { }
+
+        ConcurrentIntervalTree(const ConcurrentIntervalTree&) = delete;
+        ConcurrentIntervalTree& operator=(const ConcurrentIntervalTree&) = delete;
+
+        /**
+         * @brief Returns the currently published tree
+         * @note The snapshot never changes and stays valid for as long as it's held, even if newer versions get published
+         *       in the meantime. Hold on to it for a whole batch of queries instead of requesting a new one for every query
+         * @return Snapshot of the tree
+         */
+        [[nodiscard]] Snapshot snapshot() const {
+            return this->load();
+        }
+
+        /**
+         * @brief Modifies a copy of the current tree and publishes it
+         * @details Writers are serialized with each other but never block readers. Batch as many changes as possible into
+         *          a single call since every call copies the value storage of the tree once
+         * @param callback Callable taking a Tree& that applies the modifications
+         */
+        template<typename Callback>
+        void modify(Callback &&callback) {
+            std::scoped_lock lock(this->m_writeMutex);
+
+            auto tree = std::make_shared<Tree>(*this->load());
+            callback(*tree);
+
+            this->store(std::move(tree));
+        }
+
+        /**
+         * @brief Replaces the published tree with a completely new one
+         * @param tree Tree to publish
+         */
+        void publish(Tree tree) {
+            std::scoped_lock lock(this->m_writeMutex);
+
+            this->store(std::make_shared<const Tree>(std::move(tree)));
+        }
+
+    private:
+        // libc++ doesn't implement std::atomic<std::shared_ptr> yet, fall back to the atomic free functions there
+        #if defined(__cpp_lib_atomic_shared_ptr)
+            Snapshot load() const {
+                return this->m_current.load(std::memory_order_acquire);
+            }
+
+            void store(Snapshot snapshot) {
+                this->m_current.store(std::move(snapshot), std::memory_order_release);
+            }
+
+            std::atomic<Snapshot> m_current;
+        #else
+            Snapshot load() const {
+                return std::atomic_load_explicit(&this->m_current, std::memory_order_acquire);
+            }
+
+            void store(Snapshot snapshot) {
+                std::atomic_store_explicit(&this->m_current, std::move(snapshot), std::memory_order_release);
+            }
+
+            Snapshot m_current;
+        #endif
+
+        std::mutex m_writeMutex;
+    };
+
+}
@@ -0,0 +1,421 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace wolv::container {
+
+    namespace detail {
+
+        // Assumed size of a cache line. Indices written by different threads are kept this far apart to avoid false sharing
+        inline constexpr size_t CacheLineSize = 64;
+
+        /**
+         * @brief Rounds a ring buffer capacity up to the next power of two so indices can be wrapped with a mask
+         */
+        inline size_t ringBufferCapacity(size_t capacity) {
+            if (capacity == 0)
+                throw std::invalid_argument("Capacity must be greater than zero");
+            if (capacity > (size_t(1) << (std::numeric_limits<size_t>::digits - 2)))
+                throw std::length_error("Capacity is too large");
+
+            return std::bit_ceil(capacity);
+        }
+
+        /**
+         * @brief Number of producer and consumer threads currently sleeping on a ring buffer
+         * @details Notifying an atomic writes to a waiter table shared by the whole process, even if nobody waits. Checking
+         *          these counters first keeps the fast path free of that write. They live on their own cache line, which
+         *          is only ever written to when a thread goes to sleep, so reading them is cheap for both sides
+         */
+        struct alignas(CacheLineSize) RingBufferWaiters {
+            std::atomic<u32> producers = 0;
+            std::atomic<u32> consumers = 0;
+        };
+
+        /**
+         * @brief Blocks until an atomic no longer holds the given value
+         * @details Spins for a short while first, since the other side usually only needs a few cycles to make progress,
+         *          and only then registers itself in the waiter count and falls back to sleeping on the atomic
+         */
+        template<typename T>
+        void waitWhileEqual(const std::atomic<T> &atomic, T value, std::atomic<u32> &waiters) {
+            for (u32 i = 0; i < 64; i += 1) {
+                if (atomic.load(std::memory_order_acquire) != value)
+                    return;
+            }
+
+            // Pairs with the fence in notifyWaiters(). Either the notifying thread sees the waiter count or the wait
+            // below sees the new value and doesn't go to sleep at all
+            waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            atomic.wait(value, std::memory_order_acquire);
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Wakes up the threads sleeping on an atomic that has just been changed, if there are any
+         */
+        template<typename T>
+        void notifyWaiters(std::atomic<T> &atomic, const std::atomic<u32> &waiters) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed) != 0)
+                atomic.notify_all();
+        }
+
+        /**
+         * @brief Uninitialized storage for a ring buffer element
+         */
+        template<typename T>
+        struct RingBufferStorage {
+            alignas(T) std::byte data[sizeof(T)];
+
+            T* get() { return std::launder(reinterpret_cast<T*>(this->data)); }
+        };
+
+    }
+
+    /**
+     * @brief Bounded wait-free queue for exactly one producer and one consumer thread
+     * @details The producer only ever writes the tail index and the consumer only the head index. Both live on their own
+     *          cache line together with a cached copy of the other index, so the two threads only touch each other's
+     *          cache line when the queue looks full or empty from their side. Sleeping threads are only woken up if
+     *          there actually are any
+     * @tparam T Element type
+     */
+    template<typename T>
+    class SpscRingBuffer {
+    public:
+        /**
+         * @brief Creates a ring buffer
+         * @param capacity Minimum number of elements the buffer can hold. Gets rounded up to the next power of two
+         */
+        explicit SpscRingBuffer(size_t capacity)
+            : m_capacity(detail::ringBufferCapacity(capacity)), m_mask(m_capacity - 1),
+              m_buffer(std::make_unique<detail::RingBufferStorage<T>[]>(m_capacity)) { }
+
+        SpscRingBuffer(const SpscRingBuffer &) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer &) = delete;
+
+        ~SpscRingBuffer() {
+            if constexpr (std::is_trivially_destructible_v<T>)
+                return;
+
+            for (auto head = this->m_consumer.head.load(); head != this->m_producer.tail.load(); head += 1)
+                std::destroy_at(this->m_buffer[head & this->m_mask].get());
+        }
+
+        /**
+         * @brief Constructs an element at the end of the queue if there's space. Must only be called by the producer thread
+         * @return False if the queue is full
+         */
+        template<typename ... Args>
+        bool tryEmplace(Args && ... args) {
+            const auto tail = this->m_producer.tail.load(std::memory_order_relaxed);
+            if (tail - this->m_producer.cachedHead == this->m_capacity) {
+                this->m_producer.cachedHead = this->m_consumer.head.load(std::memory_order_acquire);
+                if (tail - this->m_producer.cachedHead == this->m_capacity)
+                    return false;
+            }
+
+            std::construct_at(this->m_buffer[tail & this->m_mask].get(), std::forward<Args>(args)...);
+            this->m_producer.tail.store(tail + 1, std::memory_order_release);
+            detail::notifyWaiters(this->m_producer.tail, this->m_waiters.consumers);
+
+            return true;
+        }
+
+        bool tryPush(const T &item) { return this->tryEmplace(item); }
+        bool tryPush(T &&item) { return this->tryEmplace(std::move(item)); }
+
+        /**
+         * @brief Constructs an element at the end of the queue, waiting for space if it's full. Must only be called by the producer thread
+         */
+        template<typename ... Args>
+        void emplace(Args && ... args) {
+            while (true) {
+                const auto head = this->m_consumer.head.load(std::memory_order_acquire);
+                if (this->m_producer.tail.load(std::memory_order_relaxed) - head != this->m_capacity)
+                    break;
+
+                detail::waitWhileEqual(this->m_consumer.head, head, this->m_waiters.producers);
+            }
+
+            this->tryEmplace(std::forward<Args>(args)...);
+        }
+
+        void push(const T &item) { this->emplace(item); }
+        void push(T &&item) { this->emplace(std::move(item)); }
+
+        /**
+         * @brief Removes the element at the front of the queue if there is one. Must only be called by the consumer thread
+         * @param out Object to move the element into
+         * @return False if the queue is empty
+         */
+        bool tryPop(T &out) {
+            const auto head = this->m_consumer.head.load(std::memory_order_relaxed);
+            if (head == this->m_consumer.cachedTail) {
+                this->m_consumer.cachedTail = this->m_producer.tail.load(std::memory_order_acquire);
+                if (head == this->m_consumer.cachedTail)
+                    return false;
+            }
+
+            auto item = this->m_buffer[head & this->m_mask].get();
+            out = std::move(*item);
+            std::destroy_at(item);
+
+            this->m_consumer.head.store(head + 1, std::memory_order_release);
+            detail::notifyWaiters(this->m_consumer.head, this->m_waiters.producers);
+
+            return true;
+        }
+
+        /**
+         * @brief Removes the element at the front of the queue, waiting for one if it's empty. Must only be called by the consumer thread
+         * @param out Object to move the element into
+         */
+        void pop(T &out) {
+            while (true) {
+                const auto tail = this->m_producer.tail.load(std::memory_order_acquire);
+                if (tail != this->m_consumer.head.load(std::memory_order_relaxed))
+                    break;
+
+                detail::waitWhileEqual(this->m_producer.tail, tail, this->m_waiters.consumers);
+            }
+
+            this->tryPop(out);
+        }
+
+        /**
+         * @brief Returns the number of elements in the queue. Only a snapshot if other threads are using the queue
+         */
+        [[nodiscard]] size_t size() const {
+            const auto head = this->m_consumer.head.load(std::memory_order_acquire);
+            const auto tail = this->m_producer.tail.load(std::memory_order_acquire);
+
+            return tail - head;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return this->size() == 0;
+        }
+
+        [[nodiscard]] size_t capacity() const {
+            return this->m_capacity;
+        }
+
+    private:
+        struct alignas(detail::CacheLineSize) Producer {
+            std::atomic<size_t> tail = 0;
+            size_t cachedHead = 0;
+        };
+
+        struct alignas(detail::CacheLineSize) Consumer {
+            std::atomic<size_t> head = 0;
+            size_t cachedTail = 0;
+        };
+
+        const size_t m_capacity, m_mask;
+        std::unique_ptr<detail::RingBufferStorage<T>[]> m_buffer;
+
+        Producer m_producer;
+        Consumer m_consumer;
+        detail::RingBufferWaiters m_waiters;
+    };
+
+    /**
+     * @brief Bounded lock-free queue for any number of producer and consumer threads
+     * @details Based on Dmitry Vyukov's bounded MPMC queue. Every slot carries a sequence number telling whether it's
+     *          ready to be written or read in the current lap around the buffer, so producers and consumers only contend
+     *          on their own index and otherwise work on different slots
+     * @tparam T Element type
+     */
+    template<typename T>
+    class MpmcRingBuffer {
+    public:
+        /**
+         * @brief Creates a ring buffer
+         * @param capacity Minimum number of elements the buffer can hold. Gets rounded up to the next power of two
+         *                 and at least 2, since a single slot's sequence numbers can't tell a full queue from an empty one
+         */
+        explicit MpmcRingBuffer(size_t capacity)
+            : m_capacity(std::max<size_t>(detail::ringBufferCapacity(capacity), 2)), m_mask(m_capacity - 1),
+              m_slots(std::make_unique<Slot[]>(m_capacity)) {
+            for (size_t i = 0; i < this->m_capacity; i += 1)
+                this->m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MpmcRingBuffer(const MpmcRingBuffer &) = delete;
+        MpmcRingBuffer& operator=(const MpmcRingBuffer &) = delete;
+
+        ~MpmcRingBuffer() {
+            if constexpr (std::is_trivially_destructible_v<T>)
+                return;
+
+            for (auto position = this->m_head.value.load(); position != this->m_tail.value.load(); position += 1)
+                std::destroy_at(this->m_slots[position & this->m_mask].storage.get());
+        }
+
+        /**
+         * @brief Constructs an element at the end of the queue if there's space
+         * @return False if the queue is full
+         */
+        template<typename ... Args>
+        bool tryEmplace(Args && ... args) {
+            return this->emplaceImpl<false>(std::forward<Args>(args)...);
+        }
+
+        bool tryPush(const T &item) { return this->tryEmplace(item); }
+        bool tryPush(T &&item) { return this->tryEmplace(std::move(item)); }
+
+        /**
+         * @brief Constructs an element at the end of the queue, waiting for space if it's full
+         */
+        template<typename ... Args>
+        void emplace(Args && ... args) {
+            this->emplaceImpl<true>(std::forward<Args>(args)...);
+        }
+
+        void push(const T &item) { this->emplace(item); }
+        void push(T &&item) { this->emplace(std::move(item)); }
+
+        /**
+         * @brief Removes the element at the front of the queue if there is one
+         * @param out Object to move the element into
+         * @return False if the queue is empty
+         */
+        bool tryPop(T &out) {
+            return this->popImpl<false>(out);
+        }
+
+        /**
+         * @brief Removes the element at the front of the queue, waiting for one if it's empty
+         * @param out Object to move the element into
+         */
+        void pop(T &out) {
+            this->popImpl<true>(out);
+        }
+
+        /**
+         * @brief Returns the number of elements in the queue. Only a snapshot if other threads are using the queue
+         */
+        [[nodiscard]] size_t size() const {
+            const auto head = this->m_head.value.load(std::memory_order_acquire);
+            const auto tail = this->m_tail.value.load(std::memory_order_acquire);
+
+            return tail > head ? std::min(tail - head, this->m_capacity) : 0;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return this->size() == 0;
+        }
+
+        [[nodiscard]] size_t capacity() const {
+            return this->m_capacity;
+        }
+
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence;
+            detail::RingBufferStorage<T> storage;
+        };
+
+        struct alignas(detail::CacheLineSize) Index {
+            std::atomic<size_t> value = 0;
+        };
+
+        /**
+         * @brief Claims the slot at the tail, constructs the element in it and hands the slot over to the consumers
+         * @details A slot is free for the producer of position p once its sequence equals p. A smaller sequence means
+         *          the consumer of the previous lap hasn't read it yet, so the queue is full
+         */
+        template<bool Blocking, typename ... Args>
+        bool emplaceImpl(Args && ... args) {
+            auto position = this->m_tail.value.load(std::memory_order_relaxed);
+            Slot *slot;
+            while (true) {
+                slot = &this->m_slots[position & this->m_mask];
+                const auto sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto difference = std::intptr_t(sequence) - std::intptr_t(position);
+
+                if (difference == 0) {
+                    if (this->m_tail.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                } else if (difference < 0) {
+                    if constexpr (!Blocking)
+                        return false;
+
+                    // Only consumers wake up producers. If a producer of the previous lap still has to fill this slot,
+                    // its change goes by unnoticed and the wake-up comes once a consumer has emptied the slot again
+                    detail::waitWhileEqual(slot->sequence, sequence, this->m_waiters.producers);
+                    position = this->m_tail.value.load(std::memory_order_relaxed);
+                } else {
+                    position = this->m_tail.value.load(std::memory_order_relaxed);
+                }
+            }
+
+            std::construct_at(slot->storage.get(), std::forward<Args>(args)...);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            detail::notifyWaiters(slot->sequence, this->m_waiters.consumers);
+
+            return true;
+        }
+
+        /**
+         * @brief Claims the slot at the head, moves the element out of it and hands the slot over to the producers of the next lap
+         * @details A slot holds the element of position p once its sequence equals p + 1
+         */
+        template<bool Blocking>
+        bool popImpl(T &out) {
+            auto position = this->m_head.value.load(std::memory_order_relaxed);
+            Slot *slot;
+            while (true) {
+                slot = &this->m_slots[position & this->m_mask];
+                const auto sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto difference = std::intptr_t(sequence) - std::intptr_t(position + 1);
+
+                if (difference == 0) {
+                    if (this->m_head.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                } else if (difference < 0) {
+                    if constexpr (!Blocking)
+                        return false;
+
+                    detail::waitWhileEqual(slot->sequence, sequence, this->m_waiters.consumers);
+                    position = this->m_head.value.load(std::memory_order_relaxed);
+                } else {
+                    position = this->m_head.value.load(std::memory_order_relaxed);
+                }
+            }
+
+            auto item = slot->storage.get();
+            out = std::move(*item);
+            std::destroy_at(item);
+
+            slot->sequence.store(position + this->m_capacity, std::memory_order_release);
+            detail::notifyWaiters(slot->sequence, this->m_waiters.producers);
+
+            return true;
+        }
+
+        const size_t m_capacity, m_mask;
+        std::unique_ptr<Slot[]> m_slots;
+
+        Index m_tail;
+        Index m_head;
+        detail::RingBufferWaiters m_waiters;
+    };
+
+}
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace wolv::container::detail {
+
+    // Number of entries per leaf block and number of children per node of the tree above the blocks
+    inline constexpr size_t IntervalIndexBlockSize = 16;
+    inline constexpr size_t IntervalIndexFanout = 8;
+
+    /**
+     * @brief Location of one level of summaries inside the summary arrays
+     */
+    struct IntervalIndexLevel {
+        u64 offset;
+        u64 size;
+    };
+
+    /**
+     * @brief Non-owning view of a sorted interval index
+     * @details Entries are sorted by start address and grouped into blocks of IntervalIndexBlockSize. Above them sits an
+     *          implicit B-tree like structure whose levels are stored bottom up as plain arrays of minimum start and
+     *          maximum end values. The lowest level summarizes one block per element, each higher level summarizes
+     *          IntervalIndexFanout elements of the level below. Queries only touch the summaries and blocks that can contain
+     *          overlapping entries, and compare a whole node or block at once. All arrays are padded to full nodes and
+     *          blocks with values that never match, so they can be compared without bounds checks
+     * @tparam Scalar The scalar type used for the interval start and end values
+     */
+    template<std::integral Scalar>
+    struct IntervalIndexView {
+        std::span<const Scalar> starts;
+        std::span<const Scalar> ends;
+        std::span<const Scalar> minStarts;
+        std::span<const Scalar> maxEnds;
+        std::span<const IntervalIndexLevel> levels;
+        size_t size = 0;
+
+        /**
+         * @brief Returns the index of the first entry starting at or after value
+         */
+        [[nodiscard]] constexpr size_t lowerBound(Scalar value) const {
+            return std::lower_bound(this->starts.begin(), this->starts.begin() + this->size, value) - this->starts.begin();
+        }
+
+        /**
+         * @brief Returns the index of the first entry starting after value
+         */
+        [[nodiscard]] constexpr size_t upperBound(Scalar value) const {
+            return std::upper_bound(this->starts.begin(), this->starts.begin() + this->size, value) - this->starts.begin();
+        }
+
+        /**
+         * @brief Returns a mask of the summaries of a node whose subtrees may contain entries overlapping the range
+         * @details The comparisons are done on the whole node without branches so they can be vectorized
+         * @param level Level of the summaries
+         * @param first Index of the first summary of the node inside the level
+         */
+        [[nodiscard]] constexpr u32 nodeMask(size_t level, u64 first, Scalar start, Scalar end) const {
+            static_assert(IntervalIndexFanout <= std::numeric_limits<u32>::digits);
+
+            const auto &summary = this->levels[level];
+            const auto nodeMinStarts = this->minStarts.data() + summary.offset + first;
+            const auto nodeMaxEnds = this->maxEnds.data() + summary.offset + first;
+
+            u32 mask = 0;
+            for (size_t i = 0; i < IntervalIndexFanout; i += 1)
+                mask |= u32((nodeMinStarts[i] <= end) & (nodeMaxEnds[i] >= start)) << i;
+
+            if (summary.size - first < IntervalIndexFanout)
+                mask &= (u32(1) << (summary.size - first)) - 1;
+
+            return mask;
+        }
+
+        /**
+         * @brief Returns a mask of the entries of a block that overlap the range
+         * @details The comparisons are done on the whole block without branches so they can be vectorized
+         */
+        [[nodiscard]] constexpr u32 blockMask(u64 block, Scalar start, Scalar end) const {
+            static_assert(IntervalIndexBlockSize <= std::numeric_limits<u32>::digits);
+
+            const auto begin = block * IntervalIndexBlockSize;
+            const auto blockStarts = this->starts.data() + begin;
+            const auto blockEnds = this->ends.data() + begin;
+
+            u32 mask = 0;
+            for (size_t i = 0; i < IntervalIndexBlockSize; i += 1)
+                mask |= u32((blockStarts[i] <= end) & (blockEnds[i] >= start)) << i;
+
+            if (this->size - begin < IntervalIndexBlockSize)
+                mask &= (u32(1) << (this->size - begin)) - 1;
+
+            return mask;
+        }
+
+        /**
+         * @brief Visits the indices of all entries overlapping the given range in sorted order
+         * @param start Start of the range
+         * @param end End of the range, inclusive
+         * @param callback Callable taking the entry index, returning false to stop the search
+         * @return False if the search got stopped by the callback
+         */
+        template<typename Callback>
+        constexpr bool visit(Scalar start, Scalar end, Callback &&callback) const {
+            if (this->levels.empty())
+                return true;
+
+            struct Item {
+                size_t level;
+                u64 index;
+            };
+
+            // Every visited node pushes at most Fanout children and only one node per level is expanded at a time
+            constexpr auto MaxDepth = std::numeric_limits<u64>::digits / std::countr_zero(IntervalIndexFanout) + 1;
+            std::array<Item, MaxDepth * IntervalIndexFanout> stack;
+            size_t stackSize = 0;
+
+            // Pushes all matching children in reverse, so they get popped in sorted order
+            const auto pushChildren = [&](size_t level, u64 first) {
+                auto mask = this->nodeMask(level, first, start, end);
+                while (mask != 0) {
+                    const auto child = std::numeric_limits<u32>::digits - 1 - std::countl_zero(mask);
+                    mask ^= u32(1) << child;
+
+                    stack[stackSize++] = { level, first + child };
+                }
+            };
+
+            pushChildren(this->levels.size() - 1, 0);
+            while (stackSize > 0) {
+                const auto [level, index] = stack[--stackSize];
+
+                if (level > 0) {
+                    pushChildren(level - 1, index * IntervalIndexFanout);
+                    continue;
+                }
+
+                auto mask = this->blockMask(index, start, end);
+                while (mask != 0) {
+                    const auto entry = index * IntervalIndexBlockSize + std::countr_zero(mask);
+                    mask &= mask - 1;
+
+                    if (!callback(size_t(entry)))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    /**
+     * @brief Pull based traversal over the entries of an interval index that overlap a range, in sorted order
+     * @details Keeps the remaining matching children of one node per level of the index, so the state stays small and
+     *          fixed in size no matter how large the index is
+     * @tparam Scalar The scalar type used for the interval start and end values
+     */
+    template<std::integral Scalar>
+    class IntervalIndexCursor {
+    public:
+        constexpr IntervalIndexCursor() = default;
+
+        constexpr IntervalIndexCursor(const IntervalIndexView<Scalar> &view, Scalar start, Scalar end)
+            : m_view(view), m_start(start), m_end(end) {
+            if (!view.levels.empty()) {
+                this->m_levelCount = view.levels.size();
+                this->m_levels[this->m_levelCount - 1] = { 0, view.nodeMask(this->m_levelCount - 1, 0, start, end) };
+            }
+        }
+
+        /**
+         * @brief Advances the cursor to the next overlapping entry
+         * @param index Set to the index of the entry
+         * @return False once all overlapping entries have been visited
+         */
+        constexpr bool next(size_t &index) {
+            while (true) {
+                if (this->m_blockMask != 0) {
+                    index = this->m_blockBase + std::countr_zero(this->m_blockMask);
+                    this->m_blockMask &= this->m_blockMask - 1;
+                    return true;
+                }
+
+                // Levels below the one currently being expanded are always exhausted
+                size_t level = 0;
+                while (level < this->m_levelCount && this->m_levels[level].mask == 0)
+                    level += 1;
+
+                if (level == this->m_levelCount)
+                    return false;
+
+                auto &state = this->m_levels[level];
+                const auto child = state.base + std::countr_zero(state.mask);
+                state.mask &= state.mask - 1;
+
+                if (level == 0) {
+                    this->m_blockBase = child * IntervalIndexBlockSize;
+                    this->m_blockMask = this->m_view.blockMask(child, this->m_start, this->m_end);
+                } else {
+                    const auto first = child * IntervalIndexFanout;
+                    this->m_levels[level - 1] = { first, this->m_view.nodeMask(level - 1, first, this->m_start, this->m_end) };
+                }
+            }
+        }
+
+    private:
+        struct LevelState {
+            u64 base;
+            u32 mask;
+        };
+
+        constexpr static size_t MaxDepth = std::numeric_limits<u64>::digits / std::countr_zero(IntervalIndexFanout) + 1;
+
+        IntervalIndexView<Scalar> m_view;
+        Scalar m_start = 0, m_end = 0;
+
+        std::array<LevelState, MaxDepth> m_levels = { };
+        size_t m_levelCount = 0;
+
+        u64 m_blockBase = 0;
+        u32 m_blockMask = 0;
+    };
+
+    /**
+     * @brief Owning storage of a sorted interval index
+     * @tparam Scalar The scalar type used for the interval start and end values
+     */
+    template<std::integral Scalar>
+    struct IntervalIndex {
+        constexpr static Scalar MinScalar = std::numeric_limits<Scalar>::lowest();
+        constexpr static Scalar MaxScalar = std::numeric_limits<Scalar>::max();
+
+        std::pmr::vector<Scalar> starts;
+        std::pmr::vector<Scalar> ends;
+        std::pmr::vector<Scalar> minStarts;
+        std::pmr::vector<Scalar> maxEnds;
+        std::pmr::vector<IntervalIndexLevel> levels;
+        size_t size = 0;
+
+        constexpr IntervalIndex() = default;
+
+        /**
+         * @brief Creates an empty index that allocates all of its arrays from the given resource
+         */
+        explicit IntervalIndex(std::pmr::memory_resource *resource)
+            : starts(resource), ends(resource), minStarts(resource), maxEnds(resource), levels(resource) { }
+
+        constexpr void reserve(size_t size) {
+            this->starts.reserve(size + IntervalIndexBlockSize);
+            this->ends.reserve(size + IntervalIndexBlockSize);
+        }
+
+        /**
+         * @brief Appends an entry. Entries have to be pushed in sorted order and before calling build()
+         */
+        constexpr void push(Scalar start, Scalar end) {
+            this->starts.push_back(start);
+            this->ends.push_back(end);
+            this->size += 1;
+        }
+
+        /**
+         * @brief Pads the entry arrays and builds the levels of the block tree
+         */
+        constexpr void build() {
+            const auto blockCount = (this->size + IntervalIndexBlockSize - 1) / IntervalIndexBlockSize;
+            this->starts.resize(blockCount * IntervalIndexBlockSize, MaxScalar);
+            this->ends.resize(blockCount * IntervalIndexBlockSize, MinScalar);
+
+            this->minStarts.clear();
+            this->maxEnds.clear();
+            this->levels.clear();
+
+            if (blockCount == 0)
+                return;
+
+            const auto addLevel = [this](size_t count, auto &&summarize) {
+                const auto offset = this->minStarts.size();
+                const auto paddedCount = (count + IntervalIndexFanout - 1) / IntervalIndexFanout * IntervalIndexFanout;
+                this->minStarts.resize(offset + paddedCount, MaxScalar);
+                this->maxEnds.resize(offset + paddedCount, MinScalar);
+
+                for (size_t i = 0; i < count; i += 1)
+                    summarize(i, this->minStarts[offset + i], this->maxEnds[offset + i]);
+
+                this->levels.push_back({ offset, count });
+            };
+
+            addLevel(blockCount, [this](size_t block, Scalar &minStart, Scalar &maxEnd) {
+                const auto begin = block * IntervalIndexBlockSize;
+                const auto end = std::min(begin + IntervalIndexBlockSize, this->size);
+
+                minStart = this->starts[begin];
+                maxEnd = *std::max_element(this->ends.begin() + begin, this->ends.begin() + end);
+            });
+
+            while (this->levels.back().size > IntervalIndexFanout) {
+                const auto below = this->levels.back();
+                addLevel((below.size + IntervalIndexFanout - 1) / IntervalIndexFanout, [this, below](size_t node, Scalar &minStart, Scalar &maxEnd) {
+                    const auto begin = below.offset + node * IntervalIndexFanout;
+
+                    minStart = this->minStarts[begin];
+                    maxEnd = *std::max_element(this->maxEnds.begin() + begin, this->maxEnds.begin() + begin + IntervalIndexFanout);
+                });
+            }
+        }
+
+        [[nodiscard]] constexpr IntervalIndexView<Scalar> view() const {
+            return { this->starts, this->ends, this->minStarts, this->maxEnds, this->levels, this->size };
+        }
+    };
+
+}
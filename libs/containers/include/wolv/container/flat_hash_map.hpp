@@ -0,0 +1,650 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define WOLV_FLAT_HASH_SSE2
+#endif
+
+namespace wolv::container {
+
+    /**
+     * @brief Default hash used by FlatHashMap and FlatHashSet
+     * @details Strings are hashed as std::string_view, which makes lookups with string views, string literals and
+     *          strings interchangeable without constructing a temporary std::string
+     */
+    template<typename Key>
+    struct FlatHash : std::hash<Key> { };
+
+    template<>
+    struct FlatHash<std::string> {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view value) const noexcept {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Control byte of a slot. Full slots store the lower 7 bits of their hash, free slots have the top bit set
+         */
+        enum class FlatHashControl : i8 {
+            Empty   = -128,
+            Deleted = -2
+        };
+
+        /**
+         * @brief Group of control bytes that is probed at once
+         * @details Matching a hash against all slots of a group takes a single compare and movemask with SSE2. Other
+         *          platforms use a plain loop that the compiler is free to vectorize
+         */
+        struct FlatHashGroup {
+            constexpr static size_t Width = 16;
+
+            explicit FlatHashGroup(const i8 *control) {
+                #if defined(WOLV_FLAT_HASH_SSE2)
+                    this->m_control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+                #else
+                    std::memcpy(this->m_control, control, Width);
+                #endif
+            }
+
+            /**
+             * @brief Returns a bit mask of all slots whose control byte equals the given value
+             */
+            [[nodiscard]] u32 match(i8 value) const {
+                #if defined(WOLV_FLAT_HASH_SSE2)
+                    return u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), this->m_control)));
+                #else
+                    u32 mask = 0;
+                    for (size_t i = 0; i < Width; i += 1)
+                        mask |= u32(this->m_control[i] == value) << i;
+                    return mask;
+                #endif
+            }
+
+            [[nodiscard]] u32 matchEmpty() const {
+                return this->match(i8(FlatHashControl::Empty));
+            }
+
+            /**
+             * @brief Returns a bit mask of all slots that are empty or deleted, meaning their top bit is set
+             */
+            [[nodiscard]] u32 matchFree() const {
+                #if defined(WOLV_FLAT_HASH_SSE2)
+                    return u32(_mm_movemask_epi8(this->m_control));
+                #else
+                    u32 mask = 0;
+                    for (size_t i = 0; i < Width; i += 1)
+                        mask |= u32(this->m_control[i] < 0) << i;
+                    return mask;
+                #endif
+            }
+
+        private:
+            #if defined(WOLV_FLAT_HASH_SSE2)
+                __m128i m_control;
+            #else
+                i8 m_control[Width];
+            #endif
+        };
+
+        template<typename Hash, typename Equal, typename Key>
+        concept FlatHashTransparent = requires {
+            typename Hash::is_transparent;
+            typename Equal::is_transparent;
+        };
+
+        /**
+         * @brief Open addressing hash table in the style of a Swiss table
+         * @details Slots are split into groups of FlatHashGroup::Width. Every slot has a control byte that tells if it's
+         *          empty, deleted or full and in the last case also stores 7 bits of the hash. A lookup hashes the key
+         *          once, uses the upper bits to pick a group and compares the remaining 7 bits against all control bytes
+         *          of the group at once. Only slots whose control byte matches get compared against the key, and the
+         *          search ends at the first group with an empty slot. Groups are probed in triangular order, which
+         *          visits every group of a power of two sized table exactly once
+         * @tparam Key Key type
+         * @tparam Mapped Mapped type or void for a set
+         */
+        template<typename Key, typename Mapped, typename Hash, typename Equal>
+        class FlatHashTable {
+        public:
+            constexpr static bool IsMap = !std::is_void_v<Mapped>;
+
+            using key_type = Key;
+            using value_type = std::conditional_t<IsMap, std::pair<const Key, std::conditional_t<IsMap, Mapped, int>>, Key>;
+            using size_type = size_t;
+            using hasher = Hash;
+            using key_equal = Equal;
+
+            template<bool Const>
+            class Iterator {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = FlatHashTable::value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+                using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+                Iterator() = default;
+
+                // Allow converting iterators to const iterators
+                template<bool OtherConst> requires (Const && !OtherConst)
+                Iterator(const Iterator<OtherConst> &other) : m_control(other.m_control), m_slot(other.m_slot), m_end(other.m_end) { }
+
+                reference operator*() const { return *this->m_slot; }
+                pointer operator->() const { return this->m_slot; }
+
+                Iterator& operator++() {
+                    this->m_control += 1;
+                    this->m_slot += 1;
+                    this->skipFree();
+
+                    return *this;
+                }
+
+                Iterator operator++(int) {
+                    auto copy = *this;
+                    ++*this;
+                    return copy;
+                }
+
+                bool operator==(const Iterator &other) const {
+                    return this->m_slot == other.m_slot;
+                }
+
+            private:
+                friend class FlatHashTable;
+                template<bool> friend class Iterator;
+
+                Iterator(const i8 *control, pointer slot, const i8 *end) : m_control(control), m_slot(slot), m_end(end) { }
+
+                void skipFree() {
+                    while (this->m_control != this->m_end && *this->m_control < 0) {
+                        this->m_control += 1;
+                        this->m_slot += 1;
+                    }
+                }
+
+                const i8 *m_control = nullptr;
+                pointer m_slot = nullptr;
+                const i8 *m_end = nullptr;
+            };
+
+            // Elements of a set are their own keys, so they can't be modified through iterators at all
+            using iterator = Iterator<!IsMap>;
+            using const_iterator = Iterator<true>;
+
+            FlatHashTable() = default;
+
+            FlatHashTable(std::initializer_list<value_type> init) {
+                this->reserve(init.size());
+                for (const auto &value : init)
+                    this->insert(value);
+            }
+
+            FlatHashTable(const FlatHashTable &other) {
+                *this = other;
+            }
+
+            FlatHashTable(FlatHashTable &&other) noexcept {
+                *this = std::move(other);
+            }
+
+            FlatHashTable& operator=(const FlatHashTable &other) {
+                if (this != &other) {
+                    this->clear();
+                    this->reserve(other.size());
+                    for (const auto &value : other)
+                        this->insert(value);
+                }
+
+                return *this;
+            }
+
+            FlatHashTable& operator=(FlatHashTable &&other) noexcept {
+                if (this != &other) {
+                    this->destroy();
+
+                    this->m_control    = std::exchange(other.m_control, nullptr);
+                    this->m_slots      = std::exchange(other.m_slots, nullptr);
+                    this->m_capacity   = std::exchange(other.m_capacity, 0);
+                    this->m_size       = std::exchange(other.m_size, 0);
+                    this->m_growthLeft = std::exchange(other.m_growthLeft, 0);
+                }
+
+                return *this;
+            }
+
+            ~FlatHashTable() {
+                this->destroy();
+            }
+
+            iterator begin() {
+                iterator result(this->m_control, this->m_slots, this->m_control + this->m_capacity);
+                result.skipFree();
+                return result;
+            }
+
+            iterator end() {
+                return iterator(this->m_control + this->m_capacity, this->m_slots + this->m_capacity, this->m_control + this->m_capacity);
+            }
+
+            const_iterator begin() const {
+                const_iterator result(this->m_control, this->m_slots, this->m_control + this->m_capacity);
+                result.skipFree();
+                return result;
+            }
+
+            const_iterator end() const {
+                return const_iterator(this->m_control + this->m_capacity, this->m_slots + this->m_capacity, this->m_control + this->m_capacity);
+            }
+
+            [[nodiscard]] size_t size() const noexcept { return this->m_size; }
+            [[nodiscard]] bool empty() const noexcept { return this->m_size == 0; }
+            [[nodiscard]] size_t capacity() const noexcept { return this->m_capacity; }
+
+            /**
+             * @brief Finds the element with the given key
+             * @note Any type the hash and equality functions accept can be used for lookups if both are transparent,
+             *       for example std::string_view for std::string keys
+             * @return Iterator to the element or end() if there is none
+             */
+            template<typename Lookup = Key>
+            iterator find(const Lookup &key) requires (std::same_as<Lookup, Key> || FlatHashTransparent<Hash, Equal, Lookup>) {
+                const auto index = this->findIndex(key, this->hash(key));
+                return index == NotFound ? this->end() : this->iteratorAt(index);
+            }
+
+            template<typename Lookup = Key>
+            const_iterator find(const Lookup &key) const requires (std::same_as<Lookup, Key> || FlatHashTransparent<Hash, Equal, Lookup>) {
+                const auto index = this->findIndex(key, this->hash(key));
+                return index == NotFound ? this->end() : const_iterator(this->iteratorAt(index));
+            }
+
+            template<typename Lookup = Key>
+            [[nodiscard]] bool contains(const Lookup &key) const requires (std::same_as<Lookup, Key> || FlatHashTransparent<Hash, Equal, Lookup>) {
+                return this->findIndex(key, this->hash(key)) != NotFound;
+            }
+
+            template<typename Lookup = Key>
+            [[nodiscard]] size_t count(const Lookup &key) const requires (std::same_as<Lookup, Key> || FlatHashTransparent<Hash, Equal, Lookup>) {
+                return this->contains(key) ? 1 : 0;
+            }
+
+            /**
+             * @brief Inserts an element if no element with the same key exists yet
+             * @return Iterator to the element with the key and whether the element got inserted
+             */
+            std::pair<iterator, bool> insert(const value_type &value) {
+                return this->emplaceImpl(keyOf(value), value);
+            }
+
+            std::pair<iterator, bool> insert(value_type &&value) {
+                return this->emplaceImpl(keyOf(value), std::move(value));
+            }
+
+            /**
+             * @brief Constructs an element in place if no element with the same key exists yet
+             * @return Iterator to the element with the key and whether the element got inserted
+             */
+            template<typename ... Args>
+            std::pair<iterator, bool> emplace(Args && ... args) {
+                value_type value(std::forward<Args>(args)...);
+                return this->emplaceImpl(keyOf(value), std::move(value));
+            }
+
+            /**
+             * @brief Erases the element with the given key
+             * @return Number of erased elements
+             */
+            template<typename Lookup = Key>
+            size_t erase(const Lookup &key) requires (std::same_as<Lookup, Key> || FlatHashTransparent<Hash, Equal, Lookup>) {
+                const auto index = this->findIndex(key, this->hash(key));
+                if (index == NotFound)
+                    return 0;
+
+                this->eraseIndex(index);
+                return 1;
+            }
+
+            /**
+             * @brief Erases the element an iterator points to
+             * @return Iterator to the next element
+             */
+            iterator erase(const_iterator position) {
+                const auto index = size_t(position.m_control - this->m_control);
+                this->eraseIndex(index);
+
+                auto result = this->iteratorAt(index);
+                result.skipFree();
+                return result;
+            }
+
+            /**
+             * @brief Removes all elements but keeps the allocated memory
+             */
+            void clear() noexcept {
+                if (this->m_capacity == 0)
+                    return;
+
+                this->destroyElements();
+                std::memset(this->m_control, i8(FlatHashControl::Empty), this->m_capacity);
+                this->m_size = 0;
+                this->m_growthLeft = maxLoad(this->m_capacity);
+            }
+
+            /**
+             * @brief Makes sure the given number of elements can be stored without rehashing
+             */
+            void reserve(size_t count) {
+                if (count > maxLoad(this->m_capacity))
+                    this->rehash(capacityFor(count));
+            }
+
+        protected:
+            constexpr static size_t NotFound = std::numeric_limits<size_t>::max();
+
+            template<typename Value>
+            static const Key& keyOf(const Value &value) {
+                if constexpr (IsMap)
+                    return value.first;
+                else
+                    return value;
+            }
+
+            /**
+             * @brief Mixes the bits of the user provided hash, since common hashes like std::hash of integers are the identity
+             */
+            template<typename Lookup>
+            size_t hash(const Lookup &key) const {
+                const auto value = u64(Hash{}(key));
+                const auto mixed = (value ^ (value >> 32)) * 0x9E3779B97F4A7C15ull;
+                return size_t(mixed ^ (mixed >> 29));
+            }
+
+            static i8 controlOf(size_t hash) {
+                return i8(hash & 0x7F);
+            }
+
+            size_t firstGroup(size_t hash) const {
+                return (hash >> 7) & (this->groupCount() - 1);
+            }
+
+            size_t groupCount() const {
+                return this->m_capacity / FlatHashGroup::Width;
+            }
+
+            template<typename Lookup>
+            size_t findIndex(const Lookup &key, size_t hash) const {
+                if (this->m_capacity == 0)
+                    return NotFound;
+
+                const auto control = controlOf(hash);
+                auto group = this->firstGroup(hash);
+                for (size_t step = 1; step <= this->groupCount(); step += 1) {
+                    const auto base = group * FlatHashGroup::Width;
+                    const FlatHashGroup probe(this->m_control + base);
+
+                    for (auto mask = probe.match(control); mask != 0; mask &= mask - 1) {
+                        const auto index = base + std::countr_zero(mask);
+                        if (Equal{}(keyOf(this->m_slots[index]), key))
+                            return index;
+                    }
+
+                    if (probe.matchEmpty() != 0)
+                        return NotFound;
+
+                    group = (group + step) & (this->groupCount() - 1);
+                }
+
+                return NotFound;
+            }
+
+            /**
+             * @brief Finds the first free slot for a hash, assuming the table has room left
+             */
+            size_t findFreeIndex(size_t hash) const {
+                auto group = this->firstGroup(hash);
+                for (size_t step = 1; ; step += 1) {
+                    const auto base = group * FlatHashGroup::Width;
+                    const auto mask = FlatHashGroup(this->m_control + base).matchFree();
+                    if (mask != 0)
+                        return base + std::countr_zero(mask);
+
+                    group = (group + step) & (this->groupCount() - 1);
+                }
+            }
+
+            template<typename Lookup, typename ... Args>
+            std::pair<iterator, bool> emplaceImpl(const Lookup &key, Args && ... args) {
+                const auto hash = this->hash(key);
+                if (const auto index = this->findIndex(key, hash); index != NotFound)
+                    return { this->iteratorAt(index), false };
+
+                if (this->m_growthLeft == 0) {
+                    // Mostly tombstones left over from erased elements can be cleaned up without growing
+                    this->rehash(this->m_size + 1 <= maxLoad(this->m_capacity) / 2 ? this->m_capacity : capacityFor(this->m_size + 1));
+                }
+
+                const auto index = this->findFreeIndex(hash);
+                std::construct_at(this->m_slots + index, std::forward<Args>(args)...);
+
+                if (this->m_control[index] == i8(FlatHashControl::Empty))
+                    this->m_growthLeft -= 1;
+                this->m_control[index] = controlOf(hash);
+                this->m_size += 1;
+
+                return { this->iteratorAt(index), true };
+            }
+
+            /**
+             * @brief Destroys an element and frees its slot
+             * @details The slot can be marked empty again if its group still has an empty slot, since then no probe
+             *          sequence ever continued past this group. Otherwise it has to stay a tombstone
+             */
+            void eraseIndex(size_t index) {
+                std::destroy_at(this->m_slots + index);
+                this->m_size -= 1;
+
+                const auto base = index / FlatHashGroup::Width * FlatHashGroup::Width;
+                if (FlatHashGroup(this->m_control + base).matchEmpty() != 0) {
+                    this->m_control[index] = i8(FlatHashControl::Empty);
+                    this->m_growthLeft += 1;
+                } else {
+                    this->m_control[index] = i8(FlatHashControl::Deleted);
+                }
+            }
+
+            iterator iteratorAt(size_t index) const {
+                return iterator(this->m_control + index, this->m_slots + index, this->m_control + this->m_capacity);
+            }
+
+            // Tables are kept at most 7/8 full
+            constexpr static size_t maxLoad(size_t capacity) {
+                return capacity - capacity / 8;
+            }
+
+            constexpr static size_t capacityFor(size_t count) {
+                auto capacity = std::bit_ceil(std::max<size_t>(count + count / 7 + 1, FlatHashGroup::Width));
+                while (maxLoad(capacity) < count)
+                    capacity *= 2;
+
+                return capacity;
+            }
+
+            void rehash(size_t capacity) {
+                auto oldControl = this->m_control;
+                auto oldSlots = this->m_slots;
+                const auto oldCapacity = this->m_capacity;
+
+                this->m_control = new i8[capacity];
+                this->m_slots = std::allocator<value_type>().allocate(capacity);
+                this->m_capacity = capacity;
+                this->m_growthLeft = maxLoad(capacity) - this->m_size;
+                std::memset(this->m_control, i8(FlatHashControl::Empty), capacity);
+
+                for (size_t index = 0; index < oldCapacity; index += 1) {
+                    if (oldControl[index] < 0)
+                        continue;
+
+                    auto &value = oldSlots[index];
+                    const auto hash = this->hash(keyOf(value));
+                    const auto newIndex = this->findFreeIndex(hash);
+
+                    relocate(this->m_slots + newIndex, value);
+                    this->m_control[newIndex] = controlOf(hash);
+                }
+
+                if (oldControl != nullptr) {
+                    delete[] oldControl;
+                    std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+                }
+            }
+
+            /**
+             * @brief Moves an element to a new slot and destroys the old one
+             * @details Map keys are const so they can't be changed through iterators. The old element is destroyed right
+             *          away, so its key gets moved from anyway instead of being copied, the same way std::node_handle does
+             */
+            static void relocate(value_type *to, value_type &from) {
+                if constexpr (IsMap)
+                    std::construct_at(to, std::piecewise_construct, std::forward_as_tuple(std::move(const_cast<Key&>(from.first))), std::forward_as_tuple(std::move(from.second)));
+                else
+                    std::construct_at(to, std::move(from));
+
+                std::destroy_at(&from);
+            }
+
+            void destroyElements() noexcept {
+                if constexpr (!std::is_trivially_destructible_v<value_type>) {
+                    for (size_t index = 0; index < this->m_capacity; index += 1) {
+                        if (this->m_control[index] >= 0)
+                            std::destroy_at(this->m_slots + index);
+                    }
+                }
+            }
+
+            void destroy() noexcept {
+                if (this->m_control == nullptr)
+                    return;
+
+                this->destroyElements();
+                delete[] this->m_control;
+                std::allocator<value_type>().deallocate(this->m_slots, this->m_capacity);
+
+                this->m_control = nullptr;
+                this->m_slots = nullptr;
+                this->m_capacity = this->m_size = this->m_growthLeft = 0;
+            }
+
+            i8 *m_control = nullptr;
+            value_type *m_slots = nullptr;
+            size_t m_capacity = 0, m_size = 0;
+
+            // Number of empty slots that can still be filled before the table has to be rehashed
+            size_t m_growthLeft = 0;
+        };
+
+    }
+
+    /**
+     * @brief Open addressing hash map that stores its elements in a flat array, see detail::FlatHashTable
+     * @note Unlike std::unordered_map, elements move around when the map grows, so pointers and iterators to them are
+     *       invalidated by every insertion that triggers a rehash. Elements are stored as std::pair<const Key, Value>
+     */
+    template<typename Key, typename Value, typename Hash = FlatHash<Key>, typename Equal = std::equal_to<>>
+    class FlatHashMap : public detail::FlatHashTable<Key, Value, Hash, Equal> {
+        using Base = detail::FlatHashTable<Key, Value, Hash, Equal>;
+
+    public:
+        using mapped_type = Value;
+        using Base::Base;
+
+        /**
+         * @brief Returns the value of a key, inserting a default constructed one if it doesn't exist yet
+         */
+        template<typename Lookup = Key>
+        Value& operator[](Lookup &&key) requires (std::same_as<std::remove_cvref_t<Lookup>, Key> || (detail::FlatHashTransparent<Hash, Equal, Lookup> && std::constructible_from<Key, Lookup>)) {
+            return this->tryEmplace(std::forward<Lookup>(key)).first->second;
+        }
+
+        /**
+         * @brief Returns the value of a key
+         * @throws std::out_of_range if the key doesn't exist
+         */
+        template<typename Lookup = Key>
+        Value& at(const Lookup &key) requires (std::same_as<Lookup, Key> || detail::FlatHashTransparent<Hash, Equal, Lookup>) {
+            const auto index = this->findIndex(key, this->hash(key));
+            if (index == Base::NotFound)
+                throw std::out_of_range("FlatHashMap key not found");
+
+            return this->m_slots[index].second;
+        }
+
+        template<typename Lookup = Key>
+        const Value& at(const Lookup &key) const requires (std::same_as<Lookup, Key> || detail::FlatHashTransparent<Hash, Equal, Lookup>) {
+            const auto index = this->findIndex(key, this->hash(key));
+            if (index == Base::NotFound)
+                throw std::out_of_range("FlatHashMap key not found");
+
+            return this->m_slots[index].second;
+        }
+
+        /**
+         * @brief Constructs a value for a key if the key doesn't exist yet
+         * @details The key is only converted to Key if it actually gets inserted
+         * @return Iterator to the element with the key and whether the element got inserted
+         */
+        template<typename Lookup, typename ... Args>
+        std::pair<typename Base::iterator, bool> tryEmplace(Lookup &&key, Args && ... args) {
+            return this->emplaceImpl(key, std::piecewise_construct, std::forward_as_tuple(std::forward<Lookup>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        /**
+         * @brief Assigns a value to a key, inserting it if it doesn't exist yet
+         * @return Iterator to the element with the key and whether the element got inserted
+         */
+        template<typename Lookup, typename Mapped>
+        std::pair<typename Base::iterator, bool> insertOrAssign(Lookup &&key, Mapped &&value) {
+            auto result = this->tryEmplace(std::forward<Lookup>(key), std::forward<Mapped>(value));
+            if (!result.second)
+                result.first->second = std::forward<Mapped>(value);
+
+            return result;
+        }
+    };
+
+    /**
+     * @brief Open addressing hash set that stores its elements in a flat array, see detail::FlatHashTable
+     * @note Elements move around when the set grows, so pointers and iterators to them are invalidated by every
+     *       insertion that triggers a rehash. Like with std::unordered_set, iterators only give const access to elements
+     */
+    template<typename Key, typename Hash = FlatHash<Key>, typename Equal = std::equal_to<>>
+    class FlatHashSet : public detail::FlatHashTable<Key, void, Hash, Equal> {
+        using Base = detail::FlatHashTable<Key, void, Hash, Equal>;
+
+    public:
+        using Base::Base;
+    };
+
+}
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <concepts>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace wolv::container {
+
+    /**
+     * @brief A map from non-overlapping intervals to values
+     * @details Unlike IntervalTree, which keeps every inserted interval as is, every address maps to at most one value.
+     *          Assigning a value to an interval overwrites that part of the existing intervals, splitting the ones
+     *          that are only partially covered. Touching intervals with equal values are merged back together, so
+     *          the number of stored segments only depends on how many distinct regions there are, not on how many
+     *          edits have been made. Looking up the value of an address takes O(log n), assigning or erasing an
+     *          interval takes O(log n + k) where k is the number of segments it replaces
+     * @tparam Type The value type to be stored
+     * @tparam Scalar The scalar type to be used for the interval start and end values
+     */
+    template<typename Type, std::integral Scalar = u64>
+    class IntervalMap {
+    public:
+        struct Interval {
+            Scalar start, end;
+
+            bool overlaps(const Interval& other) const {
+                return end >= other.start && start <= other.end;
+            }
+
+            bool operator<(const Interval& other) const {
+                return end < other.start;
+            }
+        };
+
+        struct Segment {
+            Interval interval;
+            Type value;
+        };
+
+        constexpr IntervalMap() = default;
+
+        /**
+         * @brief Construct an interval map from a list of interval/value pairs
+         * @details Pairs are assigned in order, so later ones overwrite earlier ones where they overlap
+         * @param init List of interval/value pairs
+         */
+        constexpr IntervalMap(std::initializer_list<Segment> init) {
+            for (const auto &[interval, value] : init)
+                this->assign(interval, value);
+        }
+
+        /**
+         * @brief Assigns a value to every address of an interval, overwriting previous values
+         * @param interval Interval to assign the value to
+         * @param value Value to assign
+         */
+        constexpr void assign(const Interval &interval, Type value) {
+            auto next = this->carve(interval);
+            auto iter = this->m_segments.emplace_hint(next, interval.start, Segment { interval, std::move(value) });
+
+            if (iter != this->m_segments.begin()) {
+                const auto prev = std::prev(iter);
+                if (this->mergeWithNext(prev))
+                    iter = prev;
+            }
+
+            this->mergeWithNext(iter);
+        }
+
+        /**
+         * @brief Removes the values of all addresses of an interval, splitting partially covered segments
+         * @param interval Interval to erase
+         */
+        constexpr void erase(const Interval &interval) {
+            this->carve(interval);
+        }
+
+        /**
+         * @brief Modifies the values of all addresses of an interval that currently have one
+         * @details Partially covered segments are split first so the callback only affects the given interval.
+         *          Addresses without a value are left alone. Segments that end up equal to their neighbours get merged
+         * @param interval Interval to modify
+         * @param callback Callable taking a Type& of every affected segment
+         */
+        template<typename Callback>
+        constexpr void modify(const Interval &interval, Callback &&callback) {
+            auto first = this->split(interval.start);
+            const auto last = this->splitAfter(interval.end);
+
+            if (first != this->m_segments.begin())
+                first = std::prev(first);
+
+            for (auto iter = first; iter != last; ++iter) {
+                if (iter->second.interval.start >= interval.start)
+                    callback(iter->second.value);
+            }
+
+            // Merging may remove the segment following the interval, so only check against the interval itself
+            for (auto iter = first; iter != this->m_segments.end() && iter->second.interval.start <= interval.end; ) {
+                if (!this->mergeWithNext(iter))
+                    ++iter;
+            }
+        }
+
+        /**
+         * @brief Finds the segment containing an address
+         * @param address Address to look up
+         * @return Pointer to the segment or nullptr if the address has no value
+         */
+        [[nodiscard]] constexpr const Segment* find(Scalar address) const {
+            auto iter = this->m_segments.upper_bound(address);
+            if (iter == this->m_segments.begin())
+                return nullptr;
+
+            iter = std::prev(iter);
+            if (iter->second.interval.end < address)
+                return nullptr;
+
+            return &iter->second;
+        }
+
+        /**
+         * @brief Returns the value of an address
+         * @param address Address to look up
+         * @return The value or std::nullopt if the address has no value
+         */
+        [[nodiscard]] constexpr std::optional<Type> at(Scalar address) const {
+            const auto segment = this->find(address);
+            if (segment == nullptr)
+                return std::nullopt;
+
+            return segment->value;
+        }
+
+        /**
+         * @brief Checks if an address has a value
+         * @param address Address to look up
+         */
+        [[nodiscard]] constexpr bool contains(Scalar address) const {
+            return this->find(address) != nullptr;
+        }
+
+        /**
+         * @brief Calls a callback for every segment that overlaps with the given interval, in ascending order
+         * @note Segments are passed as stored and aren't clipped to the interval. The map must not be modified from
+         *       within the callback
+         * @param interval Interval to search for
+         * @param callback Callable taking a const Segment&. If it returns a bool, returning false stops the search
+         */
+        template<typename Callback>
+        constexpr void forEachOverlapping(const Interval &interval, Callback &&callback) const {
+            auto iter = this->m_segments.upper_bound(interval.start);
+            if (iter != this->m_segments.begin() && std::prev(iter)->second.interval.end >= interval.start)
+                iter = std::prev(iter);
+
+            for (; iter != this->m_segments.end() && iter->second.interval.start <= interval.end; ++iter) {
+                if constexpr (std::is_void_v<std::invoke_result_t<Callback&, const Segment&>>) {
+                    callback(iter->second);
+                } else {
+                    if (!static_cast<bool>(callback(iter->second)))
+                        return;
+                }
+            }
+        }
+
+        /**
+         * @brief Finds all segments that overlap with the given interval
+         * @param interval Interval to search for
+         * @return Vector of all overlapping segments, sorted by ascending start address
+         */
+        [[nodiscard]] constexpr std::vector<Segment> overlapping(const Interval &interval) const {
+            std::vector<Segment> result;
+            this->forEachOverlapping(interval, [&result](const Segment &segment) {
+                result.push_back(segment);
+            });
+
+            return result;
+        }
+
+        /**
+         * @brief Clears the map
+         */
+        constexpr void clear() {
+            this->m_segments.clear();
+        }
+
+        /**
+         * @brief Returns the begin iterator over all segments in ascending order
+         */
+        constexpr auto begin() const {
+            return std::views::values(this->m_segments).begin();
+        }
+
+        /**
+         * @brief Returns the end iterator over all segments
+         */
+        constexpr auto end() const {
+            return std::views::values(this->m_segments).end();
+        }
+
+        /**
+         * @brief Returns the number of stored segments
+         */
+        [[nodiscard]] constexpr size_t size() const {
+            return this->m_segments.size();
+        }
+
+        [[nodiscard]] constexpr bool empty() const {
+            return this->m_segments.empty();
+        }
+
+    private:
+        using Map = std::map<Scalar, Segment>;
+
+        /**
+         * @brief Makes sure no segment crosses the boundary in front of the given address
+         * @return Iterator to the first segment starting at or after the address
+         */
+        constexpr typename Map::iterator split(Scalar address) {
+            auto iter = this->m_segments.upper_bound(address);
+            if (iter == this->m_segments.begin())
+                return iter;
+
+            auto &segment = std::prev(iter)->second;
+            if (segment.interval.start == address)
+                return std::prev(iter);
+            if (segment.interval.end < address)
+                return iter;
+
+            Segment tail = { { address, segment.interval.end }, segment.value };
+            segment.interval.end = address - 1;
+
+            return this->m_segments.emplace_hint(iter, address, std::move(tail));
+        }
+
+        /**
+         * @brief Makes sure no segment crosses the boundary after the given address
+         * @return Iterator to the first segment starting after the address
+         */
+        constexpr typename Map::iterator splitAfter(Scalar address) {
+            if (address == std::numeric_limits<Scalar>::max())
+                return this->m_segments.end();
+
+            return this->split(address + 1);
+        }
+
+        /**
+         * @brief Removes an interval from all segments
+         * @return Iterator to the first segment after the interval
+         */
+        constexpr typename Map::iterator carve(const Interval &interval) {
+            const auto first = this->split(interval.start);
+            const auto last = this->splitAfter(interval.end);
+
+            return this->m_segments.erase(first, last);
+        }
+
+        /**
+         * @brief Merges a segment with the one following it if they touch and have the same value
+         * @return True if the segments got merged
+         */
+        constexpr bool mergeWithNext(typename Map::iterator iter) {
+            if constexpr (std::equality_comparable<Type>) {
+                const auto next = std::next(iter);
+                if (next == this->m_segments.end())
+                    return false;
+
+                auto &segment = iter->second;
+                if (segment.interval.end == std::numeric_limits<Scalar>::max() || segment.interval.end + 1 != next->second.interval.start)
+                    return false;
+                if (!(segment.value == next->second.value))
+                    return false;
+
+                segment.interval.end = next->second.interval.end;
+                this->m_segments.erase(next);
+
+                return true;
+            } else {
+                return false;
+            }
+        }
+
+        Map m_segments;
+    };
+
+}
@@ -1,15 +1,23 @@
 #pragma once
 
 #include <wolv/types.hpp>
+#include <wolv/container/detail/interval_index.hpp>
 
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <numeric>
 #include <optional>
 #include <type_traits>
 #include <concepts>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
 
 
 namespace wolv::container {
@@ -19,6 +27,11 @@ namespace wolv::container {
      * @tparam Type The value type to be stored
      * @tparam Scalar The scalar type to be used for the interval start and end values
      * @tparam SearchRange The maximum range to search backwards to look for intervals that encompass other intervals
+     * @note Const member functions never modify any state, so a tree may be queried from any number of threads as long as
+     *       nobody writes to it at the same time. Use ConcurrentIntervalTree to publish updates while others are reading
+     * @note All storage of the tree and its index is allocated from a std::pmr::memory_resource, so a tree that only lives
+     *       for a single parse can be placed in an arena. Copies allocate new storage from the default resource but share
+     *       the immutable sorted runs of the index, so the resource has to outlive all copies of the tree as well
      */
     template<typename Type, std::integral Scalar = u64, i64 SearchRange = std::numeric_limits<i64>::max()>
     class IntervalTree {
@@ -51,35 +64,223 @@ namespace wolv::container {
             FindType value;
         };
 
+        /**
+         * @brief Unsigned type used for covered lengths. Covering the full range of Scalar wraps around to 0
+         */
+        using Length = std::make_unsigned_t<Scalar>;
+
+        /**
+         * @brief Stable reference to an interval stored in the tree
+         * @note Handles stay valid until the interval they refer to gets erased, even if other intervals are inserted or erased
+         */
+        struct Handle {
+            size_t id = InvalidSlot;
+            u32 generation = 0;
+
+            constexpr bool operator==(const Handle &other) const = default;
+        };
+
         constexpr IntervalTree() = default;
 
+        /**
+         * @brief Construct an empty interval tree that allocates all of its storage from the given resource
+         * @param resource Memory resource to allocate from
+         */
+        explicit IntervalTree(std::pmr::memory_resource *resource)
+            : m_intervals(resource), m_slotIds(resource), m_handles(resource), m_freeIds(resource), m_runs(resource), m_pending(resource) { }
+
         /**
          * @brief Construct an interval tree from a list of interval/value pairs
          * @param init List of interval/value pairs
+         * @param resource Memory resource to allocate from
          */
-        constexpr IntervalTree(std::initializer_list<InitType> &&init) {
-            for (auto &item : init)
-                this->insert(item.interval, std::move(item.value));
+        constexpr IntervalTree(std::initializer_list<InitType> &&init, std::pmr::memory_resource *resource = std::pmr::get_default_resource()) : IntervalTree(resource) {
+            this->insert(init);
         }
 
         /**
          * @brief Inserts a new interval/value pair into the tree, copying the value into the tree
          * @param interval Interval of where to insert the value
          * @param value Value to insert
+         * @return Handle to the inserted interval
          */
-        constexpr void insert(const Interval &interval, const Type &value) {
+        constexpr Handle insert(const Interval &interval, const Type &value) {
             this->m_intervals.push_back({ interval, value });
-            this->m_indexValid = false;
+            return this->addToIndex(this->m_intervals.size() - 1);
         }
 
         /**
          * @brief Inserts a new interval/value pair into the tree, moving the value into the tree
          * @param interval Interval of where to insert the value
          * @param value Value to insert
+         * @return Handle to the inserted interval
          */
-        constexpr void emplace(const Interval &interval, Type &&value) {
+        constexpr Handle emplace(const Interval &interval, Type &&value) {
             this->m_intervals.push_back({ interval, std::move(value) });
-            this->m_indexValid = false;
+            return this->addToIndex(this->m_intervals.size() - 1);
+        }
+
+        /**
+         * @brief Inserts a batch of interval/value pairs into the tree
+         * @details The batch is sorted once and then merged into the existing index in linear time, instead of going
+         *          through the insertion buffer one interval at a time. Values are moved out of the range if it's an rvalue
+         * @param range Range of elements destructurable into an interval and a value, e.g. InitType or std::pair
+         * @param alreadySorted Set to true if the range is already sorted by start and end address to skip sorting it.
+         *                      Unsorted input is still detected and sorted
+         */
+        template<std::ranges::input_range Range>
+        constexpr void insert(Range &&range, bool alreadySorted = false) {
+            this->insertRange(std::forward<Range>(range), alreadySorted, false);
+        }
+
+        /**
+         * @brief Replaces the contents of the tree with a batch of interval/value pairs
+         * @details Builds the whole index as a single compacted run in O(n) for sorted input and O(n log n) otherwise,
+         *          so aggregate queries are answered in O(log n) right away
+         * @param range Range of elements destructurable into an interval and a value, e.g. InitType or std::pair
+         * @param alreadySorted Set to true if the range is already sorted by start and end address to skip sorting it.
+         *                      Unsorted input is still detected and sorted
+         */
+        template<std::ranges::input_range Range>
+        constexpr void bulkLoad(Range &&range, bool alreadySorted = false) {
+            this->clear();
+            this->insertRange(std::forward<Range>(range), alreadySorted, true);
+        }
+
+        /**
+         * @brief Merges the whole index into a single run, dropping erased intervals, and builds its aggregates
+         * @details Takes O(n log n). Afterwards count(), coveredLength() and mergedOverlapping() run in O(log n) until
+         *          the tree gets modified again. Calling it on an already compacted tree does nothing
+         */
+        constexpr void compact() {
+            if (this->isCompact())
+                return;
+
+            Run run(this->getResource());
+            if (!this->m_pending.empty()) {
+                std::sort(this->m_pending.begin(), this->m_pending.end());
+                run = this->makeRun(this->m_pending);
+                this->m_pending.clear();
+            }
+
+            while (!this->m_runs.empty()) {
+                run = this->mergeRuns(*this->m_runs.back(), run);
+                this->m_runs.pop_back();
+            }
+
+            if (run.size() > 0)
+                this->m_runs.push_back(this->makeShared(buildRun(std::move(run), true)));
+        }
+
+
+        /**
+         * @brief Checks if a handle still refers to an interval in the tree
+         * @param handle Handle to check
+         * @return True if the interval hasn't been erased yet
+         */
+        [[nodiscard]] constexpr bool contains(const Handle &handle) const {
+            if (handle.id >= this->m_handles.size())
+                return false;
+
+            const auto &record = this->m_handles[handle.id];
+            return record.generation == handle.generation && record.slot != InvalidSlot;
+        }
+
+        /**
+         * @brief Returns the value the handle refers to
+         * @param handle Handle of the interval
+         * @return Reference to the stored value
+         */
+        [[nodiscard]] constexpr Type& at(const Handle &handle) {
+            if (!this->contains(handle))
+                throw std::out_of_range("IntervalTree handle is no longer valid");
+
+            return this->m_intervals[this->m_handles[handle.id].slot].value;
+        }
+
+        /**
+         * @brief Returns the value the handle refers to
+         * @param handle Handle of the interval
+         * @return Reference to the stored value
+         */
+        [[nodiscard]] constexpr const Type& at(const Handle &handle) const {
+            if (!this->contains(handle))
+                throw std::out_of_range("IntervalTree handle is no longer valid");
+
+            return this->m_intervals[this->m_handles[handle.id].slot].value;
+        }
+
+        /**
+         * @brief Replaces the value of an interval in place without touching the index
+         * @param handle Handle of the interval
+         * @param value New value
+         * @return True if the handle was valid and the value got replaced
+         */
+        constexpr bool update(const Handle &handle, Type value) {
+            if (!this->contains(handle))
+                return false;
+
+            this->m_intervals[this->m_handles[handle.id].slot].value = std::move(value);
+            return true;
+        }
+
+        /**
+         * @brief Erases the interval a handle refers to
+         * @param handle Handle of the interval to erase
+         * @return True if the handle was valid and the interval got erased
+         */
+        constexpr bool erase(const Handle &handle) {
+            if (!this->contains(handle))
+                return false;
+
+            this->eraseId(handle.id);
+            return true;
+        }
+
+        /**
+         * @brief Erases all intervals that exactly match the given interval
+         * @param interval Interval to erase
+         * @return Number of erased intervals
+         */
+        constexpr size_t erase(const Interval &interval) {
+            std::vector<size_t> ids;
+            for (const auto &runPointer : this->m_runs) {
+                const auto &run = *runPointer;
+                for (auto index = run.index.view().lowerBound(interval.start); index < run.size() && run.index.starts[index] == interval.start; index += 1) {
+                    if (run.index.ends[index] == interval.end && this->isAlive(run.ids[index]))
+                        ids.push_back(run.ids[index]);
+                }
+            }
+
+            for (const auto &entry : this->m_pending) {
+                if (entry.interval.start == interval.start && entry.interval.end == interval.end)
+                    ids.push_back(entry.id);
+            }
+
+            for (const auto id : ids)
+                this->eraseId(id);
+
+            return ids.size();
+        }
+
+        /**
+         * @brief Erases all intervals for which the predicate returns true
+         * @param predicate Callable taking the interval and its value
+         * @return Number of erased intervals
+         */
+        template<typename Predicate>
+        constexpr size_t eraseIf(Predicate &&predicate) {
+            std::vector<size_t> ids;
+            for (size_t slot = 0; slot < this->m_intervals.size(); slot += 1) {
+                const auto &storedInterval = this->m_intervals[slot];
+                if (predicate(std::as_const(storedInterval.interval), std::as_const(storedInterval.value)))
+                    ids.push_back(this->m_slotIds[slot]);
+            }
+
+            for (const auto id : ids)
+                this->eraseId(id);
+
+            return ids.size();
         }
 
         /**
@@ -87,17 +288,32 @@ namespace wolv::container {
          * @param searchIndex Index from which to begin looking for the next interval
          */
         constexpr std::optional<Data> nextInterval(const Scalar searchIndex) const {
-            this->ensureIndex();
+            std::optional<Entry> best;
+            const auto consider = [&best](const Entry &entry) {
+                if (!best.has_value() || entry < *best)
+                    best = entry;
+            };
 
-            auto iter = std::upper_bound(this->m_sortedIntervals.begin(), this->m_sortedIntervals.end(), searchIndex, [this](const Scalar value, const size_t index) {
-                return value < this->m_intervals[index].interval.start;
-            });
+            for (const auto &runPointer : this->m_runs) {
+                const auto &run = *runPointer;
+                auto index = run.index.view().upperBound(searchIndex);
+                while (index < run.size() && !this->isAlive(run.ids[index]))
+                    index += 1;
+
+                if (index < run.size())
+                    consider(run.entry(index));
+            }
 
-            if (iter == this->m_sortedIntervals.end())
+            for (const auto &entry : this->m_pending) {
+                if (entry.interval.start > searchIndex)
+                    consider(entry);
+            }
+
+            if (!best.has_value())
                 return std::nullopt;
 
             // Can't simply return it in one line due to std::optional
-            return this->toData(this->m_intervals[*iter]);
+            return this->toData(*best);
         }
 
         /**
@@ -105,19 +321,32 @@ namespace wolv::container {
          * @param searchIndex Index from which to begin looking for the previous interval
          */
         constexpr std::optional<Data> prevInterval(const Scalar searchIndex) const {
-            this->ensureIndex();
+            std::optional<Entry> best;
+            const auto consider = [&best](const Entry &entry) {
+                if (!best.has_value() || *best < entry)
+                    best = entry;
+            };
 
-            auto iter = std::lower_bound(this->m_sortedIntervals.begin(), this->m_sortedIntervals.end(), searchIndex, [this](const size_t index, const Scalar value) {
-                return this->m_intervals[index].interval.start < value;
-            });
+            for (const auto &runPointer : this->m_runs) {
+                const auto &run = *runPointer;
+                auto index = run.index.view().lowerBound(searchIndex);
+                while (index > 0 && !this->isAlive(run.ids[index - 1]))
+                    index -= 1;
 
-            if (iter == this->m_sortedIntervals.begin())
-                return std::nullopt;
+                if (index > 0)
+                    consider(run.entry(index - 1));
+            }
 
-            --iter; // We need to go back one to get the previous iterator
+            for (const auto &entry : this->m_pending) {
+                if (entry.interval.start < searchIndex)
+                    consider(entry);
+            }
+
+            if (!best.has_value())
+                return std::nullopt;
 
             // Can't simply return it in one line due to std::optional
-            return this->toData(this->m_intervals[*iter]);
+            return this->toData(*best);
         }
 
         /**
@@ -125,9 +354,12 @@ namespace wolv::container {
          */
         constexpr void clear() {
             this->m_intervals.clear();
-            this->m_sortedIntervals.clear();
-            this->m_nodes.clear();
-            this->m_indexValid = true;
+            this->m_slotIds.clear();
+            this->m_handles.clear();
+            this->m_freeIds.clear();
+            this->m_runs.clear();
+            this->m_pending.clear();
+            this->m_deadEntries = 0;
         }
 
         /**
@@ -166,16 +398,11 @@ namespace wolv::container {
          * @brief Finds all intervals that overlap with the given interval
          * @note If T is not trivially copyable, the returned vector will contain pointers to the values in the tree
          * @param interval Interval to search for
-         * @return Vector of all overlapping intervals and their values
+         * @return Vector of all overlapping intervals and their values, sorted by descending start address
          */
         constexpr std::vector<Data> overlapping(const Interval &interval) const {
-            if (this->m_intervals.empty())
-                return {};
-
-            this->ensureIndex();
-
             std::vector<Data> result;
-            this->overlapping(0, interval, result);
+            this->overlapping(interval, result);
 
             std::ranges::sort(result, [](const Data &left, const Data &right) {
                 if (left.interval.start != right.interval.start)
@@ -187,6 +414,163 @@ namespace wolv::container {
             return result;
         }
 
+        /**
+         * @brief Appends all intervals that overlap with the given interval to a caller provided buffer
+         * @note Unlike the returning overload, results are appended in no particular order and aren't sorted. Existing
+         *       contents of the buffer are kept, so clearing and reusing the same buffer avoids allocations altogether
+         * @param interval Interval to search for
+         * @param result Buffer to append the overlapping intervals and their values to, for example a std::vector or a SmallVector
+         */
+        template<typename Buffer> requires requires(Buffer &buffer, const Data &data) { buffer.push_back(data); }
+        constexpr void overlapping(const Interval &interval, Buffer &result) const {
+            this->visitOverlapping(interval, [this, &result](const Entry &entry) {
+                result.push_back(this->toData(entry));
+                return true;
+            });
+        }
+
+        /**
+         * @brief Calls a callback for every interval that overlaps with the given interval, without allocating
+         * @note Intervals are visited in no particular order. The tree must not be modified from within the callback
+         * @param interval Interval to search for
+         * @param callback Callable taking a const Data&. If it returns a bool, returning false stops the search
+         */
+        template<typename Callback>
+        constexpr void forEachOverlapping(const Interval &interval, Callback &&callback) const {
+            this->visitOverlapping(interval, [this, &callback](const Entry &entry) {
+                const Data data = this->toData(entry);
+
+                if constexpr (std::is_void_v<std::invoke_result_t<Callback&, const Data&>>) {
+                    callback(data);
+                    return true;
+                } else {
+                    return static_cast<bool>(callback(data));
+                }
+            });
+        }
+
+        /**
+         * @brief Checks if any interval overlaps with the given interval
+         * @param interval Interval to search for
+         * @return True as soon as one overlapping interval has been found
+         */
+        [[nodiscard]] constexpr bool anyOverlapping(const Interval &interval) const {
+            return !this->visitOverlapping(interval, [](const Entry &) {
+                return false;
+            });
+        }
+
+        /**
+         * @brief Finds the overlapping interval with the lowest start address
+         * @param interval Interval to search for
+         * @return The overlapping interval and its value, if there is one
+         */
+        [[nodiscard]] constexpr std::optional<Data> firstOverlapping(const Interval &interval) const {
+            std::optional<Entry> best;
+            const auto consider = [&best](const Entry &entry) {
+                if (!best.has_value() || entry < *best)
+                    best = entry;
+
+                return false;
+            };
+
+            // Runs are traversed in sorted order, so the first hit of each run is its lowest one
+            for (const auto &run : this->m_runs)
+                this->visitRun(*run, interval, consider);
+
+            for (const auto &entry : this->m_pending) {
+                if (interval.overlaps(entry.interval))
+                    consider(entry);
+            }
+
+            if (!best.has_value())
+                return std::nullopt;
+
+            // Can't simply return it in one line due to std::optional
+            return this->toData(*best);
+        }
+
+        /**
+         * @brief Counts the intervals that overlap with the given interval without visiting them
+         * @details Runs with aggregates are counted in O(log n) as all intervals minus the ones that start after or end
+         *          before the given interval. Without aggregates, or if intervals got erased since they were built, this
+         *          falls back to visiting the overlapping intervals. Call compact() to get back to O(log n)
+         * @param interval Interval to search for
+         * @return Number of overlapping intervals
+         */
+        [[nodiscard]] constexpr size_t count(const Interval &interval) const {
+            size_t result = 0;
+            for (const auto &runPointer : this->m_runs) {
+                const auto &run = *runPointer;
+
+                if (run.aggregated && this->m_deadEntries == 0) {
+                    const auto startedBefore = run.index.view().upperBound(interval.end);
+                    const auto endedBefore = size_t(std::lower_bound(run.sortedEnds.begin(), run.sortedEnds.end(), interval.start) - run.sortedEnds.begin());
+
+                    // Every interval that ends before the given interval also starts before it
+                    result += startedBefore - endedBefore;
+                } else {
+                    this->visitRun(run, interval, [&result](const Entry &) {
+                        result += 1;
+                        return true;
+                    });
+                }
+            }
+
+            for (const auto &entry : this->m_pending) {
+                if (interval.overlaps(entry.interval))
+                    result += 1;
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Calculates how many addresses of the given interval are covered by at least one interval in the tree
+         * @details Takes O(log n) on a compacted tree by using the prefix sums of the merged intervals. Otherwise the
+         *          merged intervals get computed on the fly, see mergedOverlapping()
+         * @param interval Interval to search for
+         * @return Number of covered addresses. Covering the entire range of Scalar wraps around to 0
+         */
+        [[nodiscard]] constexpr Length coveredLength(const Interval &interval) const {
+            if (this->isCompact()) {
+                if (this->m_runs.empty())
+                    return 0;
+
+                const auto &run = *this->m_runs.front();
+                const auto [first, last] = run.unionRange(interval);
+                if (first >= last)
+                    return 0;
+
+                Length result = run.coveredPrefix[last] - run.coveredPrefix[first];
+                if (run.unionStarts[first] < interval.start)
+                    result -= Length(interval.start) - Length(run.unionStarts[first]);
+                if (run.unionEnds[last - 1] > interval.end)
+                    result -= Length(run.unionEnds[last - 1]) - Length(interval.end);
+
+                return result;
+            }
+
+            Length result = 0;
+            for (const auto &segment : this->mergedOverlapping(interval))
+                result += segmentLength(segment.start, segment.end);
+
+            return result;
+        }
+
+        /**
+         * @brief Returns the union of all intervals that overlap with the given interval, clipped to it
+         * @details The returned input range lazily produces sorted, disjoint intervals. Overlapping and touching
+         *          intervals are joined into one. On a compacted tree every step is O(1) after an O(log n) lookup,
+         *          otherwise the sorted runs of the index are merged on the fly without collecting the overlapping intervals
+         * @note The tree must outlive the returned range and must not be modified while iterating it
+         * @param interval Interval to search for
+         * @return Range of Interval
+         */
+        [[nodiscard]] constexpr auto mergedOverlapping(const Interval &interval) const {
+            return UnionRange(*this, interval);
+        }
+
         size_t size() const {
             return m_intervals.size();
         }
@@ -195,96 +579,535 @@ namespace wolv::container {
             return m_intervals.empty();
         }
 
+        /**
+         * @brief Returns the memory resource the tree allocates its storage from
+         */
+        [[nodiscard]] std::pmr::memory_resource* getResource() const {
+            return this->m_intervals.get_allocator().resource();
+        }
+
     private:
         struct StoredInterval {
             Interval interval;
             Type value;
         };
 
-        constexpr static size_t InvalidNode = std::numeric_limits<size_t>::max();
+        /**
+         * @brief Key of a stored interval inside the index. Ordered by start, end and handle id
+         */
+        struct Entry {
+            Interval interval;
+            size_t id;
+
+            constexpr bool operator<(const Entry &other) const {
+                if (this->interval.start != other.interval.start)
+                    return this->interval.start < other.interval.start;
+                if (this->interval.end != other.interval.end)
+                    return this->interval.end < other.interval.end;
+
+                return this->id < other.id;
+            }
+        };
+
+        /**
+         * @brief Maps a handle id to the current storage slot of its interval
+         * @details Erased intervals keep their id with an invalid slot until the last index entry referring to them is
+         *          dropped. Only then the id gets reused with an incremented generation
+         */
+        struct HandleRecord {
+            size_t slot;
+            u32 generation;
+        };
+
+        constexpr static size_t InvalidSlot = std::numeric_limits<size_t>::max();
+
+        /**
+         * @brief Immutable sorted run of entries together with a block index over them
+         * @note Runs are never modified once built. Copies of a tree share them instead of duplicating the index
+         */
+        struct Run {
+            explicit Run(std::pmr::memory_resource *resource)
+                : index(resource), ids(resource), sortedEnds(resource), unionStarts(resource), unionEnds(resource), coveredPrefix(resource) { }
+
+            detail::IntervalIndex<Scalar> index;
+            std::pmr::vector<size_t> ids;
+
+            [[nodiscard]] constexpr size_t size() const {
+                return this->ids.size();
+            }
+
+            [[nodiscard]] constexpr Entry entry(size_t index) const {
+                return { { this->index.starts[index], this->index.ends[index] }, this->ids[index] };
+            }
+
+            constexpr void push(const Entry &entry) {
+                this->index.push(entry.interval.start, entry.interval.end);
+                this->ids.push_back(entry.id);
+            }
+
+            constexpr void reserve(size_t size) {
+                this->index.reserve(size);
+                this->ids.reserve(size);
+            }
+
+            // Aggregates, only built for runs created by compact() and bulkLoad(). They include dead entries, so they
+            // can only be used as long as nothing has been erased from the tree
+            bool aggregated = false;
+            std::pmr::vector<Scalar> sortedEnds;
+            std::pmr::vector<Scalar> unionStarts, unionEnds;
+            std::pmr::vector<Length> coveredPrefix;
+
+            /**
+             * @brief Returns the range of merged intervals overlapping the given interval
+             */
+            [[nodiscard]] constexpr std::pair<size_t, size_t> unionRange(const Interval &interval) const {
+                const auto first = std::lower_bound(this->unionEnds.begin(), this->unionEnds.end(), interval.start) - this->unionEnds.begin();
+                const auto last = std::upper_bound(this->unionStarts.begin(), this->unionStarts.end(), interval.end) - this->unionStarts.begin();
+
+                return { size_t(first), size_t(last) };
+            }
+        };
+
+        // Number of intervals collected in the unsorted insertion buffer before they get turned into a run
+        constexpr static size_t PendingCapacity = 32;
+
+        /**
+         * @brief Input range over the union of all intervals overlapping a query, see mergedOverlapping()
+         */
+        class UnionRange {
+        public:
+            class Iterator {
+            public:
+                using value_type = Interval;
+                using difference_type = std::ptrdiff_t;
+
+                constexpr Iterator() = default;
+
+                constexpr const Interval& operator*() const { return this->m_range->m_current; }
+                constexpr const Interval* operator->() const { return &this->m_range->m_current; }
 
-        struct Node {
-            size_t begin = 0;
-            size_t end = 0;
-            size_t left = InvalidNode;
-            size_t right = InvalidNode;
-            Scalar maxEnd = std::numeric_limits<Scalar>::lowest();
+                constexpr Iterator& operator++() {
+                    this->m_range->advance();
+                    return *this;
+                }
+
+                constexpr void operator++(int) { ++*this; }
+
+                constexpr bool operator==(std::default_sentinel_t) const { return this->m_range->m_done; }
+
+            private:
+                friend class UnionRange;
+                constexpr explicit Iterator(UnionRange *range) : m_range(range) { }
+
+                UnionRange *m_range = nullptr;
+            };
+
+            constexpr UnionRange(const IntervalTree &tree, const Interval &interval) : m_interval(interval) {
+                if (tree.isCompact()) {
+                    if (!tree.m_runs.empty()) {
+                        this->m_compactRun = tree.m_runs.front().get();
+                        std::tie(this->m_segment, this->m_segmentEnd) = this->m_compactRun->unionRange(interval);
+                    }
+                } else {
+                    this->m_tree = &tree;
+                    this->m_sources.reserve(tree.m_runs.size());
+                    for (const auto &run : tree.m_runs) {
+                        this->m_sources.push_back({ run.get(), { run->index.view(), interval.start, interval.end }, { } });
+                        this->advanceSource(this->m_sources.back());
+                    }
+
+                    for (const auto &entry : tree.m_pending) {
+                        if (interval.overlaps(entry.interval))
+                            this->m_pending[this->m_pendingCount++] = entry;
+                    }
+                    std::sort(this->m_pending.begin(), this->m_pending.begin() + this->m_pendingCount);
+                }
+
+                this->advance();
+            }
+
+            UnionRange(const UnionRange&) = delete;
+            UnionRange& operator=(const UnionRange&) = delete;
+
+            constexpr Iterator begin() { return Iterator(this); }
+            constexpr std::default_sentinel_t end() const { return { }; }
+
+        private:
+            struct Source {
+                const Run *run;
+                detail::IntervalIndexCursor<Scalar> cursor;
+                std::optional<Entry> head;
+            };
+
+            constexpr void advanceSource(Source &source) {
+                size_t index;
+                while (source.cursor.next(index)) {
+                    if (this->m_tree->isAlive(source.run->ids[index])) {
+                        source.head = source.run->entry(index);
+                        return;
+                    }
+                }
+
+                source.head.reset();
+            }
+
+            /**
+             * @brief Removes and returns the overlapping entry with the lowest start address out of all sources
+             */
+            constexpr std::optional<Entry> takeNext(std::optional<Scalar> maxStart) {
+                Source *best = nullptr;
+                for (auto &source : this->m_sources) {
+                    if (source.head.has_value() && (best == nullptr || *source.head < *best->head))
+                        best = &source;
+                }
+
+                const bool pendingAvailable = this->m_pendingIndex < this->m_pendingCount;
+                if (pendingAvailable && (best == nullptr || this->m_pending[this->m_pendingIndex] < *best->head)) {
+                    const auto &entry = this->m_pending[this->m_pendingIndex];
+                    if (maxStart.has_value() && entry.interval.start > *maxStart)
+                        return std::nullopt;
+
+                    this->m_pendingIndex += 1;
+                    return entry;
+                }
+
+                if (best == nullptr || (maxStart.has_value() && best->head->interval.start > *maxStart))
+                    return std::nullopt;
+
+                const auto entry = *best->head;
+                this->advanceSource(*best);
+                return entry;
+            }
+
+            constexpr void advance() {
+                if (this->m_compactRun != nullptr) {
+                    if (this->m_segment >= this->m_segmentEnd) {
+                        this->m_done = true;
+                        return;
+                    }
+
+                    this->setCurrent(this->m_compactRun->unionStarts[this->m_segment], this->m_compactRun->unionEnds[this->m_segment]);
+                    this->m_segment += 1;
+                    return;
+                }
+
+                const auto first = this->m_exhausted ? std::nullopt : this->takeNext(std::nullopt);
+                if (!first.has_value()) {
+                    this->m_done = true;
+                    return;
+                }
+
+                // Entries starting right after the current end still touch it. Once the end reaches the end of the
+                // query, all remaining entries would be joined as well, so there's nothing left to produce afterwards
+                auto end = first->interval.end;
+                while (!this->m_exhausted) {
+                    if (end >= this->m_interval.end) {
+                        this->m_exhausted = true;
+                        break;
+                    }
+
+                    const auto next = this->takeNext(Scalar(end + 1));
+                    if (!next.has_value())
+                        break;
+
+                    end = std::max(end, next->interval.end);
+                }
+
+                this->setCurrent(first->interval.start, end);
+            }
+
+            constexpr void setCurrent(Scalar start, Scalar end) {
+                this->m_current = { std::max(start, this->m_interval.start), std::min(end, this->m_interval.end) };
+            }
+
+            Interval m_interval;
+            Interval m_current = { };
+            bool m_done = false, m_exhausted = false;
+
+            const Run *m_compactRun = nullptr;
+            size_t m_segment = 0, m_segmentEnd = 0;
+
+            const IntervalTree *m_tree = nullptr;
+            std::vector<Source> m_sources;
+            std::array<Entry, PendingCapacity> m_pending = { };
+            size_t m_pendingCount = 0, m_pendingIndex = 0;
         };
 
-        constexpr Data toData(const StoredInterval &storedInterval) const {
+        constexpr Data toData(const Entry &entry) const {
+            const auto &storedInterval = this->m_intervals[this->m_handles[entry.id].slot];
+
             if constexpr (TriviallyCopyable)
                 return { storedInterval.interval, storedInterval.value };
             else
                 return { storedInterval.interval, std::addressof(storedInterval.value) };
         }
 
-        constexpr void ensureIndex() const {
-            if (this->m_indexValid)
+        constexpr bool isAlive(size_t id) const {
+            return this->m_handles[id].slot != InvalidSlot;
+        }
+
+        constexpr bool isAlive(const Entry &entry) const {
+            return this->isAlive(entry.id);
+        }
+
+        constexpr Handle acquireId(size_t slot) {
+            size_t id;
+            if (this->m_freeIds.empty()) {
+                id = this->m_handles.size();
+                this->m_handles.push_back({ slot, 0 });
+            } else {
+                id = this->m_freeIds.back();
+                this->m_freeIds.pop_back();
+                this->m_handles[id].slot = slot;
+            }
+
+            this->m_slotIds.push_back(id);
+            return { id, this->m_handles[id].generation };
+        }
+
+        constexpr void releaseId(size_t id) {
+            this->m_handles[id].generation += 1;
+            this->m_freeIds.push_back(id);
+        }
+
+        /**
+         * @brief Removes an interval from storage and the index
+         * @details Storage stays dense by moving the last interval into the freed slot. Pending entries are removed
+         *          right away while entries inside sorted runs are only marked as dead and get dropped the next time their
+         *          run is merged. Once dead entries make up half of the index, all runs are compacted into one
+         * @param id Handle id of a live interval
+         */
+        constexpr void eraseId(size_t id) {
+            const auto slot = this->m_handles[id].slot;
+            const auto lastSlot = this->m_intervals.size() - 1;
+            if (slot != lastSlot) {
+                this->m_intervals[slot] = std::move(this->m_intervals[lastSlot]);
+                this->m_slotIds[slot] = this->m_slotIds[lastSlot];
+                this->m_handles[this->m_slotIds[slot]].slot = slot;
+            }
+
+            this->m_intervals.pop_back();
+            this->m_slotIds.pop_back();
+            this->m_handles[id].slot = InvalidSlot;
+
+            auto pendingIter = std::find_if(this->m_pending.begin(), this->m_pending.end(), [id](const Entry &entry) { return entry.id == id; });
+            if (pendingIter != this->m_pending.end()) {
+                *pendingIter = this->m_pending.back();
+                this->m_pending.pop_back();
+                this->releaseId(id);
                 return;
+            }
 
-            this->m_sortedIntervals.resize(this->m_intervals.size());
-            std::iota(this->m_sortedIntervals.begin(), this->m_sortedIntervals.end(), size_t(0));
-            std::ranges::stable_sort(this->m_sortedIntervals, [this](size_t left, size_t right) {
-                const auto &leftInterval = this->m_intervals[left].interval;
-                const auto &rightInterval = this->m_intervals[right].interval;
+            this->m_deadEntries += 1;
+            if (this->m_deadEntries >= this->m_intervals.size())
+                this->compact();
+        }
 
-                if (leftInterval.start != rightInterval.start)
-                    return leftInterval.start < rightInterval.start;
+        /**
+         * @brief Stores a batch of interval/value pairs and adds them to the index as one sorted run
+         * @param aggregate Whether to build the aggregates of the resulting run
+         */
+        template<typename Range>
+        constexpr void insertRange(Range &&range, bool alreadySorted, bool aggregate) {
+            std::pmr::vector<Entry> entries(this->getResource());
+            if constexpr (std::ranges::sized_range<Range>) {
+                const auto count = size_t(std::ranges::size(range));
+                entries.reserve(count);
+                this->m_intervals.reserve(this->m_intervals.size() + count);
+                this->m_slotIds.reserve(this->m_slotIds.size() + count);
+            }
 
-                return leftInterval.end < rightInterval.end;
-            });
+            for (auto &&item : range) {
+                auto &&[interval, value] = item;
+                if constexpr (std::is_rvalue_reference_v<Range&&>)
+                    this->m_intervals.push_back({ interval, std::move(value) });
+                else
+                    this->m_intervals.push_back({ interval, value });
 
-            this->m_nodes.clear();
-            if (!this->m_sortedIntervals.empty())
-                this->buildNode(0, this->m_sortedIntervals.size());
+                const auto handle = this->acquireId(this->m_intervals.size() - 1);
+                entries.push_back({ interval, handle.id });
+            }
+
+            if (!alreadySorted || !std::is_sorted(entries.begin(), entries.end()))
+                std::sort(entries.begin(), entries.end());
 
-            this->m_indexValid = true;
+            // Fold the insertion buffer into the batch so everything ends up in sorted runs
+            if (!this->m_pending.empty()) {
+                const auto batchSize = entries.size();
+                std::sort(this->m_pending.begin(), this->m_pending.end());
+                entries.insert(entries.end(), this->m_pending.begin(), this->m_pending.end());
+                std::inplace_merge(entries.begin(), entries.begin() + batchSize, entries.end());
+                this->m_pending.clear();
+            }
+
+            this->addRun(this->makeRun(entries), aggregate);
         }
 
-        constexpr size_t buildNode(size_t begin, size_t end) const {
-            const auto nodeIndex = this->m_nodes.size();
-            this->m_nodes.push_back({
-                .begin = begin,
-                .end = end,
-            });
 
-            if (end - begin == 1) {
-                this->m_nodes[nodeIndex].maxEnd = this->m_intervals[this->m_sortedIntervals[begin]].interval.end;
-            } else {
-                const auto middle = begin + (end - begin) / 2;
-                const auto left = this->buildNode(begin, middle);
-                const auto right = this->buildNode(middle, end);
+        /**
+         * @brief Adds a newly stored interval to the index
+         * @details The index is a log-structured set of sorted runs whose sizes decrease geometrically. New intervals are
+         *          collected in a small buffer first. Once it's full, it gets sorted into a run, which is then merged with
+         *          all existing runs that aren't larger than it. Every interval takes part in O(log n) linear merges,
+         *          so inserting stays O(log n) amortized and queries only have to visit O(log n) runs
+         * @param slot Index of the stored interval
+         * @return Handle to the stored interval
+         */
+        constexpr Handle addToIndex(size_t slot) {
+            const auto handle = this->acquireId(slot);
+
+            this->m_pending.push_back({ this->m_intervals[slot].interval, handle.id });
+            if (this->m_pending.size() < PendingCapacity)
+                return handle;
 
-                this->m_nodes[nodeIndex].left = left;
-                this->m_nodes[nodeIndex].right = right;
-                this->m_nodes[nodeIndex].maxEnd = std::max(this->m_nodes[left].maxEnd, this->m_nodes[right].maxEnd);
+            std::sort(this->m_pending.begin(), this->m_pending.end());
+
+            this->addRun(this->makeRun(this->m_pending));
+            this->m_pending.clear();
+
+            return handle;
+        }
+
+        /**
+         * @brief Adds a sorted batch of entries to the index, merging it with all runs that aren't larger than it
+         * @param run Sorted entries
+         * @param aggregate Whether to build the aggregates of the resulting run
+         */
+        constexpr void addRun(Run &&run, bool aggregate = false) {
+            while (!this->m_runs.empty() && this->m_runs.back()->size() <= run.size()) {
+                run = this->mergeRuns(*this->m_runs.back(), run);
+                this->m_runs.pop_back();
             }
 
-            return nodeIndex;
+            if (run.size() > 0)
+                this->m_runs.push_back(this->makeShared(buildRun(std::move(run), aggregate)));
         }
 
-        constexpr void overlapping(size_t nodeIndex, const Interval &interval, std::vector<Data> &result) const {
-            const auto &node = this->m_nodes[nodeIndex];
-            const auto minStart = this->m_intervals[this->m_sortedIntervals[node.begin]].interval.start;
+        constexpr Run makeRun(std::span<const Entry> entries) {
+            Run run(this->getResource());
+            run.reserve(entries.size());
+            for (const auto &entry : entries)
+                run.push(entry);
 
-            if (node.maxEnd < interval.start || minStart > interval.end)
-                return;
+            return run;
+        }
 
-            if (node.end - node.begin == 1) {
-                const auto &storedInterval = this->m_intervals[this->m_sortedIntervals[node.begin]];
-                if (interval.overlaps(storedInterval.interval))
-                    result.push_back(this->toData(storedInterval));
-                return;
+        constexpr Run mergeRuns(const Run &left, const Run &right) {
+            Run run(this->getResource());
+            run.reserve(left.size() + right.size());
+
+            // Dead entries are only referenced by the runs being merged, so their ids can be reused afterwards
+            const auto append = [this, &run](const Run &source, size_t index) {
+                const auto id = source.ids[index];
+                if (this->isAlive(id)) {
+                    run.push(source.entry(index));
+                } else {
+                    this->releaseId(id);
+                    this->m_deadEntries -= 1;
+                }
+            };
+
+            size_t leftIndex = 0, rightIndex = 0;
+            while (leftIndex < left.size() && rightIndex < right.size()) {
+                if (right.entry(rightIndex) < left.entry(leftIndex))
+                    append(right, rightIndex++);
+                else
+                    append(left, leftIndex++);
+            }
+
+            while (leftIndex < left.size())
+                append(left, leftIndex++);
+            while (rightIndex < right.size())
+                append(right, rightIndex++);
+
+            return run;
+        }
+
+        constexpr static Run buildRun(Run &&run, bool aggregate) {
+            if (aggregate) {
+                run.sortedEnds.assign(run.index.ends.begin(), run.index.ends.begin() + run.size());
+                std::sort(run.sortedEnds.begin(), run.sortedEnds.end());
+
+                // Entries are sorted by start, so a single pass joins all overlapping and touching intervals
+                run.coveredPrefix.push_back(0);
+                for (size_t index = 0; index < run.size(); index += 1) {
+                    const auto start = run.index.starts[index], end = run.index.ends[index];
+
+                    if (!run.unionEnds.empty() && (start <= run.unionEnds.back() || Length(start) - Length(run.unionEnds.back()) == 1)) {
+                        run.unionEnds.back() = std::max(run.unionEnds.back(), end);
+                    } else {
+                        run.unionStarts.push_back(start);
+                        run.unionEnds.push_back(end);
+                    }
+                }
+
+                for (size_t segment = 0; segment < run.unionStarts.size(); segment += 1)
+                    run.coveredPrefix.push_back(run.coveredPrefix.back() + segmentLength(run.unionStarts[segment], run.unionEnds[segment]));
+
+                run.aggregated = true;
+            }
+
+            run.index.build();
+
+            return std::move(run);
+        }
+
+        /**
+         * @brief Places a finished run and its reference count in the memory resource of the tree
+         */
+        std::shared_ptr<const Run> makeShared(Run &&run) const {
+            return std::allocate_shared<Run>(std::pmr::polymorphic_allocator<Run>(this->getResource()), std::move(run));
+        }
+
+        constexpr static Length segmentLength(Scalar start, Scalar end) {
+            return Length(Length(end) - Length(start) + 1);
+        }
+
+        /**
+         * @brief Checks if the whole index is a single run with valid aggregates
+         */
+        constexpr bool isCompact() const {
+            return this->m_pending.empty() && this->m_deadEntries == 0 && (this->m_runs.empty() || (this->m_runs.size() == 1 && this->m_runs.front()->aggregated));
+        }
+
+        /**
+         * @brief Visits all live entries overlapping the given interval
+         * @param interval Interval to search for
+         * @param callback Callable taking a const Entry&, returning false to stop the search
+         * @return False if the search got stopped by the callback
+         */
+        template<typename Callback>
+        constexpr bool visitOverlapping(const Interval &interval, Callback &&callback) const {
+            for (const auto &run : this->m_runs) {
+                if (!this->visitRun(*run, interval, callback))
+                    return false;
             }
 
-            this->overlapping(node.left, interval, result);
-            this->overlapping(node.right, interval, result);
+            for (const auto &entry : this->m_pending) {
+                if (interval.overlaps(entry.interval) && !callback(entry))
+                    return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Visits all live entries of a run overlapping the given interval in sorted order
+         */
+        template<typename Callback>
+        constexpr bool visitRun(const Run &run, const Interval &interval, Callback &&callback) const {
+            return run.index.view().visit(interval.start, interval.end, [this, &run, &callback](size_t index) {
+                return !this->isAlive(run.ids[index]) || callback(run.entry(index));
+            });
         }
 
-        std::vector<StoredInterval> m_intervals;
-        mutable std::vector<size_t> m_sortedIntervals;
-        mutable std::vector<Node> m_nodes;
-        mutable bool m_indexValid = true;
+        std::pmr::vector<StoredInterval> m_intervals;
+        std::pmr::vector<size_t> m_slotIds;
+        std::pmr::vector<HandleRecord> m_handles;
+        std::pmr::vector<size_t> m_freeIds;
+        std::pmr::vector<std::shared_ptr<const Run>> m_runs;
+        std::pmr::vector<Entry> m_pending;
+        size_t m_deadEntries = 0;
     };
 
 }
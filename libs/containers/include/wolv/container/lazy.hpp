@@ -1,8 +1,16 @@
 #pragma once
 
+#include <wolv/types.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace wolv::container {
 
@@ -60,4 +68,235 @@ namespace wolv::container {
         mutable std::once_flag initFlag_;
     };
 
-}
\ No newline at end of file
+    namespace detail {
+
+        /**
+         * @brief In-place storage for a lazily computed value together with its initialization state
+         * @details Once the value is ready, reading it only costs a single acquire load. While one thread is computing
+         *          the value, all others sleep on the state until it's done
+         */
+        template<typename T>
+        class LazyValue {
+        public:
+            LazyValue() = default;
+
+            LazyValue(const LazyValue &) = delete;
+            LazyValue& operator=(const LazyValue &) = delete;
+
+            ~LazyValue() {
+                if (this->m_state.load(std::memory_order_acquire) == State::Ready)
+                    std::destroy_at(this->pointer());
+            }
+
+            [[nodiscard]] bool isReady() const {
+                return this->m_state.load(std::memory_order_acquire) == State::Ready;
+            }
+
+            /**
+             * @brief Returns the value. Only valid once isReady() returned true
+             */
+            [[nodiscard]] T& value() {
+                return *this->pointer();
+            }
+
+            /**
+             * @brief Computes the value unless another thread is already doing so or it's already done
+             * @param initializer Callable returning the value
+             * @param storeErrors If true, exceptions get stored and are rethrown by every get() call. Otherwise they are
+             *                    thrown to the caller and the next get() call tries again
+             */
+            template<typename Initializer>
+            void tryInitialize(Initializer &initializer, bool storeErrors) {
+                auto expected = State::Empty;
+                if (!this->m_state.compare_exchange_strong(expected, State::Running, std::memory_order_acquire))
+                    return;
+
+                try {
+                    std::construct_at(this->pointer(), std::invoke(initializer));
+                    this->m_state.store(State::Ready, std::memory_order_release);
+                } catch (...) {
+                    if (!storeErrors) {
+                        this->m_state.store(State::Empty, std::memory_order_release);
+                        this->m_state.notify_all();
+                        throw;
+                    }
+
+                    this->m_error = std::current_exception();
+                    this->m_state.store(State::Failed, std::memory_order_release);
+                }
+
+                this->m_state.notify_all();
+            }
+
+            /**
+             * @brief Returns the value, computing it on the calling thread or waiting for another thread if necessary
+             */
+            template<typename Initializer>
+            T& get(Initializer &initializer, bool storeErrors) {
+                while (true) {
+                    const auto state = this->m_state.load(std::memory_order_acquire);
+                    switch (state) {
+                        case State::Ready:
+                            return *this->pointer();
+                        case State::Failed:
+                            std::rethrow_exception(this->m_error);
+                        case State::Empty:
+                            this->tryInitialize(initializer, storeErrors);
+                            break;
+                        case State::Running:
+                            this->m_state.wait(state, std::memory_order_acquire);
+                            break;
+                    }
+                }
+            }
+
+        private:
+            enum class State : u8 {
+                Empty,
+                Running,
+                Ready,
+                Failed
+            };
+
+            T* pointer() {
+                return std::launder(reinterpret_cast<T*>(this->m_storage));
+            }
+
+            std::atomic<State> m_state = State::Empty;
+            alignas(T) std::byte m_storage[sizeof(T)];
+            std::exception_ptr m_error;
+        };
+
+    }
+
+    /**
+     * @brief Lazily computed value that is stored in place without any heap allocations
+     * @details Unlike Lazy, the initializer is stored as its own type instead of a std::function and the value lives
+     *          inside the object itself. After initialization, get() only does a single acquire load. If the
+     *          initializer throws, the exception is passed on and the next call to get() tries again
+     * @tparam T Type of the value
+     * @tparam Initializer Callable type returning the value
+     */
+    template<typename T, typename Initializer = std::function<T()>>
+    class InplaceLazy {
+    public:
+        explicit InplaceLazy(Initializer initializer) : m_initializer(std::move(initializer)) { }
+
+        InplaceLazy(const InplaceLazy&) = delete;
+        InplaceLazy& operator=(const InplaceLazy&) = delete;
+
+        /**
+         * @brief Returns the value, computing it first if that hasn't happened yet
+         */
+        T& get() {
+            if (this->m_value.isReady()) [[likely]]
+                return this->m_value.value();
+
+            return this->m_value.get(this->m_initializer, false);
+        }
+
+        const T& get() const {
+            if (this->m_value.isReady()) [[likely]]
+                return this->m_value.value();
+
+            return this->m_value.get(this->m_initializer, false);
+        }
+
+        T& operator*() { return this->get(); }
+        const T& operator*() const { return this->get(); }
+        T* operator->() { return &this->get(); }
+        const T* operator->() const { return &this->get(); }
+
+        [[nodiscard]] bool isInitialized() const {
+            return this->m_value.isReady();
+        }
+
+    private:
+        mutable Initializer m_initializer;
+        mutable detail::LazyValue<T> m_value;
+    };
+
+    template<typename Initializer>
+    InplaceLazy(Initializer) -> InplaceLazy<std::invoke_result_t<Initializer&>, Initializer>;
+
+    /**
+     * @brief Lazily computed value whose computation is started in the background right away
+     * @details The initializer is enqueued on a thread pool when the object is created. get() returns immediately if
+     *          the value is ready, waits if a worker is currently computing it and computes it on the calling thread
+     *          if no worker has picked it up yet, so it never waits on a busy pool. Exceptions thrown by the initializer
+     *          are rethrown by every call to get()
+     * @tparam T Type of the value
+     */
+    template<typename T>
+    class AsyncLazy {
+    public:
+        /**
+         * @brief Starts computing the value in the background
+         * @param pool Thread pool providing enqueue(Task), like wolv::util::ThreadPool
+         * @param initializer Callable returning the value
+         */
+        template<typename Pool, typename Initializer>
+        AsyncLazy(Pool &pool, Initializer &&initializer)
+            : m_state(std::make_shared<StateImpl<std::decay_t<Initializer>>>(std::forward<Initializer>(initializer))) {
+            // The task keeps the state alive, so the object may be destroyed before the task gets to run
+            pool.enqueue([state = this->m_state](const std::atomic<bool> &stop) {
+                if (!stop)
+                    state->initialize();
+            });
+        }
+
+        AsyncLazy(const AsyncLazy&) = delete;
+        AsyncLazy& operator=(const AsyncLazy&) = delete;
+        AsyncLazy(AsyncLazy&&) noexcept = default;
+        AsyncLazy& operator=(AsyncLazy&&) noexcept = default;
+
+        /**
+         * @brief Returns the value, waiting for it or computing it on the calling thread if it isn't ready yet
+         */
+        T& get() {
+            if (this->m_state->value.isReady()) [[likely]]
+                return this->m_state->value.value();
+
+            return this->m_state->get();
+        }
+
+        const T& get() const {
+            if (this->m_state->value.isReady()) [[likely]]
+                return this->m_state->value.value();
+
+            return this->m_state->get();
+        }
+
+        T& operator*() { return this->get(); }
+        const T& operator*() const { return this->get(); }
+        T* operator->() { return &this->get(); }
+        const T* operator->() const { return &this->get(); }
+
+        [[nodiscard]] bool isReady() const {
+            return this->m_state->value.isReady();
+        }
+
+    private:
+        struct State {
+            virtual ~State() = default;
+
+            virtual void initialize() = 0;
+            virtual T& get() = 0;
+
+            detail::LazyValue<T> value;
+        };
+
+        template<typename Initializer>
+        struct StateImpl : State {
+            explicit StateImpl(Initializer initializer) : initializer(std::move(initializer)) { }
+
+            void initialize() override { this->value.tryInitialize(this->initializer, true); }
+            T& get() override { return this->value.get(this->initializer, true); }
+
+            Initializer initializer;
+        };
+
+        std::shared_ptr<State> m_state;
+    };
+
+}
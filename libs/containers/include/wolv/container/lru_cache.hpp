@@ -0,0 +1,371 @@
+#pragma once
+
+#include <wolv/types.hpp>
+#include <wolv/container/flat_hash_map.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace wolv::container {
+
+    /**
+     * @brief Default cost function of LruCache, every entry costs the same
+     */
+    struct LruUnitCost {
+        template<typename Key, typename Value>
+        constexpr size_t operator()(const Key &, const Value &) const {
+            return 1;
+        }
+    };
+
+    /**
+     * @brief Thread safe cache that evicts the least recently used entries once their total cost exceeds a budget
+     * @details Entries are distributed over independently locked shards by their hash, so threads working on different
+     *          keys rarely contend for the same lock. Every shard keeps its own recency list while the cost budget is
+     *          shared by all of them. Inserting into a full cache evicts from the end of the shard that's inserted into
+     *          first and only moves on to the other shards if that's not enough, so with more than one shard the order
+     *          is only approximately least recently used. The entry that's just been inserted is never evicted, even if
+     *          it's more expensive than the whole budget. Values are handed out as shared pointers, so evicting an
+     *          entry never invalidates a value that's still in use somewhere else
+     * @tparam Key The key type
+     * @tparam Value The value type
+     * @tparam Cost Callable taking a key and a value, returning the cost of the entry. Defaults to 1 per entry
+     * @tparam Hash Hash function for the keys
+     * @tparam Equal Equality function for the keys
+     */
+    template<typename Key, typename Value, typename Cost = LruUnitCost, typename Hash = FlatHash<Key>, typename Equal = std::equal_to<>>
+    class LruCache {
+    public:
+        using Pointer = std::shared_ptr<const Value>;
+
+        struct Statistics {
+            u64 hits = 0;
+            u64 misses = 0;
+            u64 coalescedMisses = 0;
+            u64 evictions = 0;
+            size_t size = 0;
+            size_t cost = 0;
+
+            /**
+             * @brief Returns the fraction of lookups that have been served from the cache
+             */
+            [[nodiscard]] double getHitRate() const {
+                const auto lookups = this->hits + this->misses + this->coalescedMisses;
+                return lookups == 0 ? 0.0 : double(this->hits) / double(lookups);
+            }
+        };
+
+        /**
+         * @brief Creates a cache
+         * @param maxCost Total cost the entries of the cache may have
+         * @param shardCount Number of independently locked shards, rounded up to a power of two. Use a single shard
+         *                   for an exact least recently used order across all keys
+         */
+        explicit LruCache(size_t maxCost, size_t shardCount = 16)
+            : m_maxCost(maxCost),
+              m_shardCount(std::bit_ceil(std::max<size_t>(shardCount, 1))),
+              m_shards(std::make_unique<Shard[]>(m_shardCount)) { }
+
+        LruCache(const LruCache &) = delete;
+        LruCache& operator=(const LruCache &) = delete;
+
+        /**
+         * @brief Looks up a value and marks it as recently used
+         * @return The value or nullptr if the key isn't cached
+         */
+        [[nodiscard]] Pointer get(const Key &key) {
+            auto &shard = this->shardOf(key);
+            std::scoped_lock lock(shard.mutex);
+
+            const auto iter = shard.index.find(key);
+            if (iter == shard.index.end()) {
+                shard.misses += 1;
+                return nullptr;
+            }
+
+            shard.hits += 1;
+            shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+            return iter->second->value;
+        }
+
+        /**
+         * @brief Checks if a key is cached without counting as a use of it
+         */
+        [[nodiscard]] bool contains(const Key &key) const {
+            auto &shard = this->shardOf(key);
+            std::scoped_lock lock(shard.mutex);
+
+            return shard.index.contains(key);
+        }
+
+        /**
+         * @brief Inserts a value, replacing the previous value of the key
+         * @return The inserted value
+         */
+        Pointer insert(const Key &key, Value value) {
+            auto pointer = std::make_shared<const Value>(std::move(value));
+
+            auto &shard = this->shardOf(key);
+            {
+                std::scoped_lock lock(shard.mutex);
+                this->store(shard, key, pointer);
+            }
+
+            this->evictFromOtherShards(shard, pointer);
+            return pointer;
+        }
+
+        /**
+         * @brief Returns the cached value of a key, computing and inserting it first if it's missing
+         * @details If multiple threads miss the same key at the same time, only the first one computes the value while
+         *          the others wait for it. The computation runs without holding any lock. If it throws, the exception is
+         *          rethrown in all waiting threads and nothing gets cached
+         * @param key Key to look up
+         * @param compute Callable returning the value, optionally taking the key
+         * @return The cached or computed value
+         */
+        template<typename Compute>
+        Pointer getOrCompute(const Key &key, Compute &&compute) {
+            auto &shard = this->shardOf(key);
+
+            std::promise<Pointer> promise;
+            {
+                std::unique_lock lock(shard.mutex);
+
+                if (const auto iter = shard.index.find(key); iter != shard.index.end()) {
+                    shard.hits += 1;
+                    shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+                    return iter->second->value;
+                }
+
+                if (const auto iter = shard.pending.find(key); iter != shard.pending.end()) {
+                    shard.coalescedMisses += 1;
+                    auto future = iter->second;
+                    lock.unlock();
+
+                    return future.get();
+                }
+
+                shard.misses += 1;
+                shard.pending.emplace(key, promise.get_future().share());
+            }
+
+            Pointer pointer;
+            try {
+                if constexpr (std::invocable<Compute&, const Key&>)
+                    pointer = std::make_shared<const Value>(compute(key));
+                else
+                    pointer = std::make_shared<const Value>(compute());
+            } catch (...) {
+                {
+                    std::scoped_lock lock(shard.mutex);
+                    shard.pending.erase(key);
+                }
+
+                promise.set_exception(std::current_exception());
+                throw;
+            }
+
+            {
+                std::scoped_lock lock(shard.mutex);
+                shard.pending.erase(key);
+                this->store(shard, key, pointer);
+            }
+
+            this->evictFromOtherShards(shard, pointer);
+            promise.set_value(pointer);
+            return pointer;
+        }
+
+        /**
+         * @brief Removes a key from the cache
+         * @return True if the key was cached
+         */
+        bool erase(const Key &key) {
+            auto &shard = this->shardOf(key);
+            std::scoped_lock lock(shard.mutex);
+
+            const auto iter = shard.index.find(key);
+            if (iter == shard.index.end())
+                return false;
+
+            this->m_cost -= iter->second->cost;
+            shard.entries.erase(iter->second);
+            shard.index.erase(iter);
+
+            return true;
+        }
+
+        /**
+         * @brief Removes all entries. Computations that are still running will insert their values once they're done
+         */
+        void clear() {
+            for (size_t i = 0; i < this->m_shardCount; i += 1) {
+                auto &shard = this->m_shards[i];
+                std::scoped_lock lock(shard.mutex);
+
+                for (const auto &entry : shard.entries)
+                    this->m_cost -= entry.cost;
+
+                shard.entries.clear();
+                shard.index.clear();
+            }
+        }
+
+        /**
+         * @brief Returns the number of cached entries
+         */
+        [[nodiscard]] size_t size() const {
+            return this->getStatistics().size;
+        }
+
+        /**
+         * @brief Returns the total cost of all cached entries
+         */
+        [[nodiscard]] size_t getCost() const {
+            return this->m_cost;
+        }
+
+        [[nodiscard]] size_t getMaxCost() const {
+            return this->m_maxCost;
+        }
+
+        /**
+         * @brief Returns the statistics of all shards combined
+         */
+        [[nodiscard]] Statistics getStatistics() const {
+            Statistics result;
+            for (size_t i = 0; i < this->m_shardCount; i += 1) {
+                const auto &shard = this->m_shards[i];
+                std::scoped_lock lock(shard.mutex);
+
+                result.hits            += shard.hits;
+                result.misses          += shard.misses;
+                result.coalescedMisses += shard.coalescedMisses;
+                result.evictions       += shard.evictions;
+                result.size            += shard.entries.size();
+            }
+
+            result.cost = this->m_cost;
+            return result;
+        }
+
+        void resetStatistics() {
+            for (size_t i = 0; i < this->m_shardCount; i += 1) {
+                auto &shard = this->m_shards[i];
+                std::scoped_lock lock(shard.mutex);
+
+                shard.hits = shard.misses = shard.coalescedMisses = shard.evictions = 0;
+            }
+        }
+
+    private:
+        struct Entry {
+            Key key;
+            Pointer value;
+            size_t cost;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        // Shards are aligned to separate cache lines, so locking one doesn't slow down threads working on its neighbours
+        struct alignas(64) Shard {
+            mutable std::mutex mutex;
+
+            // Most recently used entries first
+            EntryList entries;
+            FlatHashMap<Key, typename EntryList::iterator, Hash, Equal> index;
+            FlatHashMap<Key, std::shared_future<Pointer>, Hash, Equal> pending;
+
+            u64 hits = 0, misses = 0, coalescedMisses = 0, evictions = 0;
+        };
+
+        Shard& shardOf(const Key &key) const {
+            if (this->m_shardCount == 1)
+                return this->m_shards[0];
+
+            // Use the upper bits of a separately mixed hash, the tables inside the shards index with the lower ones
+            auto hash = u64(Hash{}(key));
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 33;
+
+            return this->m_shards[hash >> (64 - std::countr_zero(this->m_shardCount))];
+        }
+
+        /**
+         * @brief Inserts or replaces an entry and evicts least recently used entries of the same shard until the cache
+         *        fits its budget
+         * @note Has to be called with the lock of the shard held
+         */
+        void store(Shard &shard, const Key &key, const Pointer &value) {
+            const size_t cost = Cost{}(key, *value);
+
+            if (const auto iter = shard.index.find(key); iter != shard.index.end()) {
+                auto &entry = *iter->second;
+                this->m_cost += cost;
+                this->m_cost -= entry.cost;
+                entry.value = value;
+                entry.cost = cost;
+                shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+            } else {
+                shard.entries.push_front({ key, value, cost });
+                shard.index.emplace(key, shard.entries.begin());
+                this->m_cost += cost;
+            }
+
+            this->evict(shard, value);
+        }
+
+        /**
+         * @brief Evicts least recently used entries of a shard until the cache fits its budget
+         * @param keep Value of the entry that has just been inserted, which never gets evicted
+         * @note Has to be called with the lock of the shard held
+         */
+        void evict(Shard &shard, const Pointer &keep) {
+            while (this->m_cost > this->m_maxCost && !shard.entries.empty()) {
+                const auto &victim = shard.entries.back();
+                if (victim.value == keep)
+                    break;
+
+                this->m_cost -= victim.cost;
+                shard.index.erase(victim.key);
+                shard.entries.pop_back();
+                shard.evictions += 1;
+            }
+        }
+
+        /**
+         * @brief Evicts entries of the shards following the one that has been inserted into, if evicting from that one
+         *        alone wasn't enough to fit the budget
+         * @note Must be called without holding any shard lock
+         */
+        void evictFromOtherShards(const Shard &origin, const Pointer &keep) {
+            const auto first = size_t(&origin - this->m_shards.get());
+            for (size_t i = 1; i < this->m_shardCount && this->m_cost > this->m_maxCost; i += 1) {
+                auto &shard = this->m_shards[(first + i) & (this->m_shardCount - 1)];
+
+                std::scoped_lock lock(shard.mutex);
+                this->evict(shard, keep);
+            }
+        }
+
+        size_t m_maxCost;
+        size_t m_shardCount;
+        std::unique_ptr<Shard[]> m_shards;
+
+        // Total cost of all shards. Only changed with the lock of the shard the cost belongs to held
+        std::atomic<size_t> m_cost = 0;
+    };
+
+}
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <wolv/types.hpp>
+#include <wolv/container/interval_tree.hpp>
+#include <wolv/container/detail/interval_index.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace wolv::container {
+
+    /**
+     * @brief Read-only interval tree that is queried directly from a serialized buffer, e.g. a memory mapped file
+     * @details The serialized format consists of a header followed by the sorted start and end arrays, the values in the
+     *          same order and the summary levels of the block index. All sections are aligned to 64 bytes and stored in
+     *          native byte order, so a mapped file can be queried in place without deserializing anything. The header
+     *          records the format version, byte order, scalar and value layout, and loading rejects any buffer that
+     *          doesn't match this instantiation exactly
+     * @tparam Type The value type stored in the tree. Has to be trivially copyable
+     * @tparam Scalar The scalar type used for the interval start and end values
+     */
+    template<typename Type, std::integral Scalar = u64>
+    class MappedIntervalTree {
+        static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable values can be serialized");
+
+    public:
+        using Tree = IntervalTree<Type, Scalar>;
+        using Interval = typename Tree::Interval;
+        using Data = typename Tree::Data;
+
+        constexpr static u32 FormatVersion = 1;
+
+        MappedIntervalTree() = default;
+
+        /**
+         * @brief Serializes the contents of an interval tree
+         * @param tree Tree to serialize
+         * @return Serialized tree that can be written to a file and loaded again with load()
+         */
+        template<i64 SearchRange>
+        [[nodiscard]] static std::vector<u8> serialize(const IntervalTree<Type, Scalar, SearchRange> &tree) {
+            std::vector<Data> data;
+            data.reserve(tree.size());
+            for (const auto &[interval, value] : tree)
+                data.push_back({ { interval.start, interval.end }, value });
+
+            std::ranges::stable_sort(data, [](const auto &left, const auto &right) {
+                if (left.interval.start != right.interval.start)
+                    return left.interval.start < right.interval.start;
+
+                return left.interval.end < right.interval.end;
+            });
+
+            detail::IntervalIndex<Scalar> index;
+            index.reserve(data.size());
+            for (const auto &item : data)
+                index.push(item.interval.start, item.interval.end);
+            index.build();
+
+            Header header = { };
+            header.magic = Magic;
+            header.version = FormatVersion;
+            header.byteOrder = ByteOrderMark;
+            header.headerSize = sizeof(Header);
+            header.scalarSize = sizeof(Scalar);
+            header.scalarSigned = std::is_signed_v<Scalar>;
+            header.valueSize = sizeof(Type);
+            header.valueAlignment = alignof(Type);
+            header.blockSize = detail::IntervalIndexBlockSize;
+            header.fanout = detail::IntervalIndexFanout;
+            header.count = index.size;
+            header.paddedCount = index.starts.size();
+            header.summaryCount = index.minStarts.size();
+            header.levelCount = index.levels.size();
+
+            u64 offset = sizeof(Header);
+            const auto allocate = [&offset](u64 size) {
+                offset = alignUp(offset);
+                const auto result = offset;
+                offset += size;
+
+                return result;
+            };
+
+            header.startsOffset     = allocate(header.paddedCount * sizeof(Scalar));
+            header.endsOffset       = allocate(header.paddedCount * sizeof(Scalar));
+            header.valuesOffset     = allocate(header.count * sizeof(Type));
+            header.minStartsOffset  = allocate(header.summaryCount * sizeof(Scalar));
+            header.maxEndsOffset    = allocate(header.summaryCount * sizeof(Scalar));
+            header.levelsOffset     = allocate(header.levelCount * sizeof(detail::IntervalIndexLevel));
+            header.totalSize        = offset;
+
+            std::vector<u8> result(header.totalSize, 0x00);
+            const auto write = [&result](u64 offset, const void *source, size_t size) {
+                if (size > 0)
+                    std::memcpy(result.data() + offset, source, size);
+            };
+
+            write(0, &header, sizeof(Header));
+            write(header.startsOffset, index.starts.data(), index.starts.size() * sizeof(Scalar));
+            write(header.endsOffset, index.ends.data(), index.ends.size() * sizeof(Scalar));
+            write(header.minStartsOffset, index.minStarts.data(), index.minStarts.size() * sizeof(Scalar));
+            write(header.maxEndsOffset, index.maxEnds.data(), index.maxEnds.size() * sizeof(Scalar));
+            write(header.levelsOffset, index.levels.data(), index.levels.size() * sizeof(detail::IntervalIndexLevel));
+
+            for (size_t i = 0; i < data.size(); i += 1)
+                write(header.valuesOffset + i * sizeof(Type), &data[i].value, sizeof(Type));
+
+            return result;
+        }
+
+        /**
+         * @brief Loads a serialized tree from a buffer without copying it
+         * @note The buffer has to stay alive and unchanged for as long as the tree is used. It also needs to be aligned
+         *       to at least 64 bytes, which memory mappings always are
+         * @param buffer Serialized tree
+         * @return The loaded tree or std::nullopt if the buffer doesn't contain a valid tree matching this instantiation
+         */
+        [[nodiscard]] static std::optional<MappedIntervalTree> load(std::span<const u8> buffer) {
+            if (buffer.size() < sizeof(Header) || reinterpret_cast<uintptr_t>(buffer.data()) % SectionAlignment != 0)
+                return std::nullopt;
+
+            Header header;
+            std::memcpy(&header, buffer.data(), sizeof(Header));
+
+            if (header.magic != Magic || header.version != FormatVersion || header.byteOrder != ByteOrderMark)
+                return std::nullopt;
+            if (header.headerSize != sizeof(Header) || header.scalarSize != sizeof(Scalar) || header.scalarSigned != std::is_signed_v<Scalar>)
+                return std::nullopt;
+            if (header.valueSize != sizeof(Type) || header.valueAlignment != alignof(Type))
+                return std::nullopt;
+            if (header.blockSize != detail::IntervalIndexBlockSize || header.fanout != detail::IntervalIndexFanout)
+                return std::nullopt;
+            if (header.totalSize > buffer.size())
+                return std::nullopt;
+
+            // Make sure all sections are aligned, lie inside the buffer and match the expected index shape
+            const auto blockCount = (header.count + detail::IntervalIndexBlockSize - 1) / detail::IntervalIndexBlockSize;
+            if (header.paddedCount != blockCount * detail::IntervalIndexBlockSize)
+                return std::nullopt;
+
+            const auto checkSection = [&header](u64 offset, u64 count, u64 elementSize) {
+                return offset % SectionAlignment == 0 &&
+                       offset >= sizeof(Header) &&
+                       count <= header.totalSize / std::max<u64>(elementSize, 1) &&
+                       offset <= header.totalSize - count * elementSize;
+            };
+
+            if (!checkSection(header.startsOffset, header.paddedCount, sizeof(Scalar)) ||
+                !checkSection(header.endsOffset, header.paddedCount, sizeof(Scalar)) ||
+                !checkSection(header.valuesOffset, header.count, sizeof(Type)) ||
+                !checkSection(header.minStartsOffset, header.summaryCount, sizeof(Scalar)) ||
+                !checkSection(header.maxEndsOffset, header.summaryCount, sizeof(Scalar)) ||
+                !checkSection(header.levelsOffset, header.levelCount, sizeof(detail::IntervalIndexLevel)))
+                return std::nullopt;
+
+            MappedIntervalTree tree;
+            tree.m_index.starts     = { reinterpret_cast<const Scalar*>(buffer.data() + header.startsOffset), header.paddedCount };
+            tree.m_index.ends       = { reinterpret_cast<const Scalar*>(buffer.data() + header.endsOffset), header.paddedCount };
+            tree.m_index.minStarts  = { reinterpret_cast<const Scalar*>(buffer.data() + header.minStartsOffset), header.summaryCount };
+            tree.m_index.maxEnds    = { reinterpret_cast<const Scalar*>(buffer.data() + header.maxEndsOffset), header.summaryCount };
+            tree.m_index.levels     = { reinterpret_cast<const detail::IntervalIndexLevel*>(buffer.data() + header.levelsOffset), header.levelCount };
+            tree.m_index.size       = header.count;
+            tree.m_values           = { reinterpret_cast<const Type*>(buffer.data() + header.valuesOffset), header.count };
+
+            if (!tree.validateLevels(blockCount))
+                return std::nullopt;
+
+            return tree;
+        }
+
+        /**
+         * @brief Loads a serialized tree from a memory mapped file, like a wolv::io::File after calling map()
+         * @note The file has to stay mapped for as long as the tree is used
+         * @param file Mapped file containing a serialized tree
+         * @return The loaded tree or std::nullopt if the file isn't mapped or doesn't contain a valid tree
+         */
+        template<typename File> requires requires(const File &file) { file.getMapping(); file.getSize(); }
+        [[nodiscard]] static std::optional<MappedIntervalTree> load(const File &file) {
+            const u8 *mapping = file.getMapping();
+            if (mapping == nullptr)
+                return std::nullopt;
+
+            return load(std::span<const u8>(mapping, file.getSize()));
+        }
+
+        /**
+         * @brief Finds all intervals that overlap with the given interval
+         * @param interval Interval to search for
+         * @return Vector of all overlapping intervals and their values, sorted by descending start address
+         */
+        [[nodiscard]] std::vector<Data> overlapping(const Interval &interval) const {
+            std::vector<Data> result;
+            this->overlapping(interval, result);
+
+            std::ranges::sort(result, [](const Data &left, const Data &right) {
+                if (left.interval.start != right.interval.start)
+                    return left.interval.start > right.interval.start;
+
+                return left.interval.end < right.interval.end;
+            });
+
+            return result;
+        }
+
+        /**
+         * @brief Appends all intervals that overlap with the given interval to a caller provided buffer
+         * @param interval Interval to search for
+         * @param result Buffer to append the overlapping intervals and their values to, in ascending start address order
+         */
+        void overlapping(const Interval &interval, std::vector<Data> &result) const {
+            this->m_index.visit(interval.start, interval.end, [this, &result](size_t index) {
+                result.push_back(this->toData(index));
+                return true;
+            });
+        }
+
+        /**
+         * @brief Calls a callback for every interval that overlaps with the given interval, in ascending start address order
+         * @param interval Interval to search for
+         * @param callback Callable taking a const Data&. If it returns a bool, returning false stops the search
+         */
+        template<typename Callback>
+        void forEachOverlapping(const Interval &interval, Callback &&callback) const {
+            this->m_index.visit(interval.start, interval.end, [this, &callback](size_t index) {
+                const Data data = this->toData(index);
+
+                if constexpr (std::is_void_v<std::invoke_result_t<Callback&, const Data&>>) {
+                    callback(data);
+                    return true;
+                } else {
+                    return static_cast<bool>(callback(data));
+                }
+            });
+        }
+
+        /**
+         * @brief Checks if any interval overlaps with the given interval
+         * @param interval Interval to search for
+         * @return True as soon as one overlapping interval has been found
+         */
+        [[nodiscard]] bool anyOverlapping(const Interval &interval) const {
+            return !this->m_index.visit(interval.start, interval.end, [](size_t) {
+                return false;
+            });
+        }
+
+        /**
+         * @brief Finds the overlapping interval with the lowest start address
+         * @param interval Interval to search for
+         * @return The overlapping interval and its value, if there is one
+         */
+        [[nodiscard]] std::optional<Data> firstOverlapping(const Interval &interval) const {
+            std::optional<Data> result;
+            this->m_index.visit(interval.start, interval.end, [this, &result](size_t index) {
+                result = this->toData(index);
+                return false;
+            });
+
+            return result;
+        }
+
+        /**
+         * @brief Returns the nearest interval located after the searchIndex, if it exists
+         * @param searchIndex Index from which to begin looking for the next interval
+         */
+        [[nodiscard]] std::optional<Data> nextInterval(const Scalar searchIndex) const {
+            const auto index = this->m_index.upperBound(searchIndex);
+            if (index >= this->m_index.size)
+                return std::nullopt;
+
+            return this->toData(index);
+        }
+
+        /**
+         * @brief Returns the nearest interval located before the searchIndex, if it exists
+         * @param searchIndex Index from which to begin looking for the previous interval
+         */
+        [[nodiscard]] std::optional<Data> prevInterval(const Scalar searchIndex) const {
+            const auto index = this->m_index.lowerBound(searchIndex);
+            if (index == 0)
+                return std::nullopt;
+
+            return this->toData(index - 1);
+        }
+
+        [[nodiscard]] size_t size() const {
+            return this->m_index.size;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return this->m_index.size == 0;
+        }
+
+    private:
+        struct Header {
+            std::array<char, 8> magic;
+            u32 version;
+            u32 byteOrder;
+            u32 headerSize;
+            u32 scalarSize;
+            u32 scalarSigned;
+            u32 valueSize;
+            u32 valueAlignment;
+            u32 blockSize;
+            u32 fanout;
+            u32 reserved;
+            u64 count;
+            u64 paddedCount;
+            u64 summaryCount;
+            u64 levelCount;
+            u64 startsOffset;
+            u64 endsOffset;
+            u64 valuesOffset;
+            u64 minStartsOffset;
+            u64 maxEndsOffset;
+            u64 levelsOffset;
+            u64 totalSize;
+        };
+
+        static_assert(std::is_trivially_copyable_v<Header>);
+
+        constexpr static std::array<char, 8> Magic = { 'W', 'O', 'L', 'V', 'I', 'T', 'R', 'E' };
+        constexpr static u32 ByteOrderMark = 0x01020304;
+        constexpr static u64 SectionAlignment = 64;
+
+        constexpr static u64 alignUp(u64 value) {
+            return (value + SectionAlignment - 1) / SectionAlignment * SectionAlignment;
+        }
+
+        /**
+         * @brief Checks that the summary levels describe the tree shape that's expected for the number of entries
+         * @details Queries trust the level offsets and sizes, so a corrupted file must never get past this
+         */
+        [[nodiscard]] bool validateLevels(u64 blockCount) const {
+            u64 expectedSize = blockCount;
+            for (size_t level = 0; level < this->m_index.levels.size(); level += 1) {
+                const auto &[offset, size] = this->m_index.levels[level];
+                const auto paddedSize = (size + detail::IntervalIndexFanout - 1) / detail::IntervalIndexFanout * detail::IntervalIndexFanout;
+
+                if (size != expectedSize || offset > this->m_index.minStarts.size() || paddedSize > this->m_index.minStarts.size() - offset)
+                    return false;
+
+                const auto isTopLevel = level + 1 == this->m_index.levels.size();
+                if (isTopLevel != (size <= detail::IntervalIndexFanout))
+                    return false;
+
+                expectedSize = (size + detail::IntervalIndexFanout - 1) / detail::IntervalIndexFanout;
+            }
+
+            return this->m_index.levels.empty() == (blockCount == 0);
+        }
+
+        [[nodiscard]] Data toData(size_t index) const {
+            return { { this->m_index.starts[index], this->m_index.ends[index] }, this->m_values[index] };
+        }
+
+        detail::IntervalIndexView<Scalar> m_index;
+        std::span<const Type> m_values;
+    };
+
+}
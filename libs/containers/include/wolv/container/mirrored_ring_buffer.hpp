@@ -0,0 +1,179 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace wolv::container {
+
+    /**
+     * @brief Byte ring buffer whose storage is mapped twice, back to back, into virtual memory
+     * @details Both mappings refer to the same physical pages, so reading or writing past the end of the first mapping
+     *          continues at the start of the buffer. Because of that, the readable and the writable part of the buffer
+     *          are always a single contiguous span, no matter where they wrap around, and data can be parsed in place
+     *          without ever copying it into a linear buffer first
+     * @note The capacity is rounded up to a power of two that is at least the allocation granularity of the system
+     */
+    class MirroredRingBuffer {
+    public:
+        /**
+         * @brief Creates a mirrored ring buffer
+         * @param capacity Minimum number of bytes the buffer can hold
+         * @throws std::runtime_error if the memory mappings couldn't be created
+         */
+        explicit MirroredRingBuffer(size_t capacity) {
+            if (capacity == 0)
+                throw std::invalid_argument("Capacity must be greater than zero");
+
+            this->m_capacity = std::bit_ceil((std::max)(capacity, allocationGranularity()));
+            this->m_mask = this->m_capacity - 1;
+
+            this->m_data = createMirroredMapping(this->m_capacity);
+            if (this->m_data == nullptr)
+                throw std::runtime_error("Failed to create mirrored ring buffer mapping");
+        }
+
+        MirroredRingBuffer(const MirroredRingBuffer &) = delete;
+        MirroredRingBuffer& operator=(const MirroredRingBuffer &) = delete;
+
+        MirroredRingBuffer(MirroredRingBuffer &&other) noexcept {
+            *this = std::move(other);
+        }
+
+        MirroredRingBuffer& operator=(MirroredRingBuffer &&other) noexcept {
+            if (this != &other) {
+                this->release();
+
+                this->m_data     = std::exchange(other.m_data, nullptr);
+                this->m_capacity = std::exchange(other.m_capacity, 0);
+                this->m_mask     = std::exchange(other.m_mask, 0);
+                this->m_head     = std::exchange(other.m_head, 0);
+                this->m_tail     = std::exchange(other.m_tail, 0);
+            }
+
+            return *this;
+        }
+
+        ~MirroredRingBuffer() {
+            this->release();
+        }
+
+        /**
+         * @brief Returns all stored bytes as one contiguous span, oldest first
+         * @details Call consume() once the bytes have been processed
+         */
+        [[nodiscard]] std::span<u8> readable() noexcept {
+            return { this->m_data + (this->m_tail & this->m_mask), this->size() };
+        }
+
+        [[nodiscard]] std::span<const u8> readable() const noexcept {
+            return { this->m_data + (this->m_tail & this->m_mask), this->size() };
+        }
+
+        /**
+         * @brief Returns the free space of the buffer as one contiguous span
+         * @details Write bytes into it directly, for example by reading from a file or socket into it, then call
+         *          commitWrite() with the number of bytes written
+         */
+        [[nodiscard]] std::span<u8> writable() noexcept {
+            return { this->m_data + (this->m_head & this->m_mask), this->m_capacity - this->size() };
+        }
+
+        /**
+         * @brief Appends bytes that have been written into the writable span
+         * @param count Number of bytes written, at most the size of the writable span
+         */
+        void commitWrite(size_t count) {
+            if (count > this->m_capacity - this->size())
+                throw std::out_of_range("MirroredRingBuffer write exceeds free space");
+
+            this->m_head += count;
+        }
+
+        /**
+         * @brief Removes bytes from the front of the buffer
+         * @param count Number of bytes to remove, at most size()
+         */
+        void consume(size_t count) {
+            if (count > this->size())
+                throw std::out_of_range("MirroredRingBuffer consume exceeds size");
+
+            this->m_tail += count;
+        }
+
+        /**
+         * @brief Appends as many bytes as there is free space for with a single copy
+         * @param data Bytes to append
+         * @return Number of bytes that were appended
+         */
+        size_t pushSpan(std::span<const u8> data) {
+            const auto writable = this->writable();
+            const auto count = (std::min)(data.size(), writable.size());
+
+            if (count > 0)
+                std::memcpy(writable.data(), data.data(), count);
+            this->m_head += count;
+
+            return count;
+        }
+
+        /**
+         * @brief Removes bytes from the front of the buffer with a single copy
+         * @param out Span to fill
+         * @return Number of bytes that were removed
+         */
+        size_t popSpan(std::span<u8> out) {
+            const auto readable = this->readable();
+            const auto count = (std::min)(out.size(), readable.size());
+
+            if (count > 0)
+                std::memcpy(out.data(), readable.data(), count);
+            this->m_tail += count;
+
+            return count;
+        }
+
+        [[nodiscard]] size_t size() const noexcept {
+            return size_t(this->m_head - this->m_tail);
+        }
+
+        [[nodiscard]] size_t capacity() const noexcept {
+            return this->m_capacity;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return this->m_head == this->m_tail;
+        }
+
+        [[nodiscard]] bool full() const noexcept {
+            return this->size() == this->m_capacity;
+        }
+
+        void clear() noexcept {
+            this->m_head = this->m_tail = 0;
+        }
+
+    private:
+        static size_t allocationGranularity();
+
+        /**
+         * @brief Maps the same size bytes of memory twice, directly after each other
+         * @return Start of the first mapping or nullptr on failure
+         */
+        static u8* createMirroredMapping(size_t size);
+
+        void release() noexcept;
+
+        u8 *m_data = nullptr;
+        size_t m_capacity = 0, m_mask = 0;
+
+        // Positions keep counting up and only get wrapped when accessing the data
+        u64 m_head = 0, m_tail = 0;
+    };
+
+}
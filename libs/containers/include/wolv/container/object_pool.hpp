@@ -0,0 +1,360 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace wolv::container {
+
+    namespace detail {
+
+        constexpr static size_t SlabMinBlockSize = 16;
+        constexpr static size_t SlabMaxBlockSize = 0x1000;
+        constexpr static size_t SlabSize = 0x10000;
+
+        constexpr size_t slabClassOf(size_t bytes) {
+            return size_t(std::countr_zero(std::bit_ceil(std::max(bytes, SlabMinBlockSize))) - std::countr_zero(SlabMinBlockSize));
+        }
+
+        constexpr static size_t SlabClassCount = slabClassOf(SlabMaxBlockSize) + 1;
+
+        /**
+         * @brief Hands out blocks of a single size from large slabs
+         * @details Every thread keeps a free list of its own that's served without any locking. Once a thread caches too
+         *          many blocks, a batch of them is moved to a global list, where threads with an empty cache take whole
+         *          batches from. Threads give back their cache when they exit. Slabs are never returned to the system,
+         *          so the pool stays usable from static destructors
+         */
+        template<size_t BlockSize>
+        class SlabPool {
+            static_assert(std::has_single_bit(BlockSize) && BlockSize >= SlabMinBlockSize);
+
+        public:
+            // Number of blocks moved between the cache of a thread and the global pool at once
+            constexpr static size_t BatchSize = std::clamp<size_t>(0x2000 / BlockSize, 4, 64);
+
+            [[nodiscard]] static void* allocate() {
+                auto &cache = s_cache;
+                if (cache.chain.head == nullptr) [[unlikely]] {
+                    if (cache.destroyed)
+                        return Global::get().takeBatch(1).head;
+
+                    registerCache();
+                    cache.chain = Global::get().takeBatch(BatchSize);
+                }
+
+                const auto block = cache.chain.head;
+                cache.chain.head = block->next;
+                cache.chain.count -= 1;
+
+                return block;
+            }
+
+            static void deallocate(void *pointer) noexcept {
+                const auto block = static_cast<Block*>(pointer);
+
+                auto &cache = s_cache;
+                if (cache.destroyed) [[unlikely]] {
+                    block->next = nullptr;
+                    Global::get().giveBack({ block, 1 });
+                    return;
+                }
+
+                if (!cache.registered) [[unlikely]]
+                    registerCache();
+
+                block->next = cache.chain.head;
+                cache.chain.head = block;
+                cache.chain.count += 1;
+
+                // Keep one batch around for the next allocations and hand the rest to other threads
+                if (cache.chain.count >= BatchSize * 2) [[unlikely]] {
+                    auto last = cache.chain.head;
+                    for (size_t i = 1; i < BatchSize; i += 1)
+                        last = last->next;
+
+                    Global::get().giveBack({ last->next, cache.chain.count - BatchSize });
+                    last->next = nullptr;
+                    cache.chain.count = BatchSize;
+                }
+            }
+
+            [[nodiscard]] static size_t getBytesReserved() {
+                return Global::get().getBytesReserved();
+            }
+
+        private:
+            struct Block {
+                Block *next;
+            };
+
+            struct Chain {
+                Block *head = nullptr;
+                size_t count = 0;
+            };
+
+            struct Cache {
+                Chain chain;
+                bool registered, destroyed;
+            };
+
+            struct Releaser {
+                ~Releaser() {
+                    auto &cache = s_cache;
+                    cache.destroyed = true;
+                    Global::get().giveBack(cache.chain);
+                    cache.chain = { };
+                }
+            };
+
+            class Global {
+            public:
+                static Global& get() {
+                    // Intentionally leaked, blocks may still be freed by destructors of other static objects
+                    static auto instance = new Global();
+                    return *instance;
+                }
+
+                Chain takeBatch(size_t count) {
+                    std::scoped_lock lock(this->m_mutex);
+
+                    if (this->m_batches.empty())
+                        this->addSlab();
+
+                    auto &batch = this->m_batches.back();
+                    if (batch.count <= count) {
+                        const auto result = batch;
+                        this->m_batches.pop_back();
+                        return result;
+                    }
+
+                    // Split off the front of a batch, only happens for threads that already exited
+                    Chain result = { batch.head, count };
+                    auto last = batch.head;
+                    for (size_t i = 1; i < count; i += 1)
+                        last = last->next;
+
+                    batch.head = last->next;
+                    batch.count -= count;
+                    last->next = nullptr;
+
+                    return result;
+                }
+
+                void giveBack(Chain chain) {
+                    if (chain.count == 0)
+                        return;
+
+                    std::scoped_lock lock(this->m_mutex);
+                    this->m_batches.push_back(chain);
+                }
+
+                size_t getBytesReserved() {
+                    std::scoped_lock lock(this->m_mutex);
+                    return this->m_bytesReserved;
+                }
+
+            private:
+                void addSlab() {
+                    constexpr static size_t BlocksPerSlab = std::max(SlabSize / BlockSize, BatchSize);
+
+                    auto slab = static_cast<std::byte*>(::operator new(BlocksPerSlab * BlockSize));
+                    this->m_bytesReserved += BlocksPerSlab * BlockSize;
+
+                    for (size_t first = 0; first < BlocksPerSlab; first += BatchSize) {
+                        const auto count = std::min(BatchSize, BlocksPerSlab - first);
+
+                        Block *head = nullptr;
+                        for (size_t i = first + count; i > first; i -= 1) {
+                            auto block = reinterpret_cast<Block*>(slab + (i - 1) * BlockSize);
+                            block->next = head;
+                            head = block;
+                        }
+
+                        this->m_batches.push_back({ head, count });
+                    }
+                }
+
+                std::mutex m_mutex;
+                std::vector<Chain> m_batches;
+                size_t m_bytesReserved = 0;
+            };
+
+            // Touching the releaser makes sure the cache gets handed back once this thread exits
+            static void registerCache() {
+                static_cast<void>(&s_releaser);
+                s_cache.registered = true;
+            }
+
+            static inline thread_local constinit Cache s_cache = { { }, false, false };
+            static inline thread_local Releaser s_releaser;
+        };
+
+        template<size_t... Classes>
+        void* slabAllocate(size_t slabClass, std::index_sequence<Classes...>) {
+            void *result = nullptr;
+            (void)((slabClass == Classes && (result = SlabPool<(SlabMinBlockSize << Classes)>::allocate(), true)) || ...);
+
+            return result;
+        }
+
+        template<size_t... Classes>
+        void slabDeallocate(void *pointer, size_t slabClass, std::index_sequence<Classes...>) noexcept {
+            (void)((slabClass == Classes && (SlabPool<(SlabMinBlockSize << Classes)>::deallocate(pointer), true)) || ...);
+        }
+
+        template<size_t... Classes>
+        size_t slabBytesReserved(std::index_sequence<Classes...>) {
+            return (SlabPool<(SlabMinBlockSize << Classes)>::getBytesReserved() + ...);
+        }
+
+        constexpr bool isSlabAllocation(size_t bytes, size_t alignment) {
+            return bytes <= SlabMaxBlockSize && alignment <= alignof(std::max_align_t);
+        }
+
+        /**
+         * @brief Allocates memory from the slab pool of the matching size, or from operator new if it's too large for any
+         */
+        [[nodiscard]] inline void* allocate(size_t bytes, size_t alignment) {
+            if (!isSlabAllocation(bytes, alignment))
+                return ::operator new(bytes, std::align_val_t(alignment));
+
+            return slabAllocate(slabClassOf(bytes), std::make_index_sequence<SlabClassCount>());
+        }
+
+        /**
+         * @brief Frees memory returned by allocate(). Size and alignment have to be the same as the ones it was allocated with
+         */
+        inline void deallocate(void *pointer, size_t bytes, size_t alignment) noexcept {
+            if (!isSlabAllocation(bytes, alignment)) {
+                ::operator delete(pointer, bytes, std::align_val_t(alignment));
+                return;
+            }
+
+            slabDeallocate(pointer, slabClassOf(bytes), std::make_index_sequence<SlabClassCount>());
+        }
+
+    }
+
+    /**
+     * @brief Creates and destroys objects in memory taken from thread caching slab pools
+     * @details Creating and destroying an object on the same thread is a couple of pointer operations without any
+     *          locking. Objects may be destroyed on a different thread than they've been created on, the memory then
+     *          flows back to the other threads in batches
+     * @tparam T Type of the objects
+     */
+    template<typename T>
+    class ObjectPool {
+    public:
+        struct Deleter {
+            void operator()(T *object) const noexcept {
+                ObjectPool::destroy(object);
+            }
+        };
+
+        using Pointer = std::unique_ptr<T, Deleter>;
+
+        ObjectPool() = delete;
+
+        template<typename ... Args>
+        [[nodiscard]] static T* create(Args && ... args) {
+            auto memory = detail::allocate(sizeof(T), alignof(T));
+
+            try {
+                return ::new (memory) T(std::forward<Args>(args)...);
+            } catch (...) {
+                detail::deallocate(memory, sizeof(T), alignof(T));
+                throw;
+            }
+        }
+
+        static void destroy(T *object) noexcept {
+            if (object == nullptr)
+                return;
+
+            object->~T();
+            detail::deallocate(object, sizeof(T), alignof(T));
+        }
+
+        template<typename ... Args>
+        [[nodiscard]] static Pointer make(Args && ... args) {
+            return Pointer(create(std::forward<Args>(args)...));
+        }
+    };
+
+    /**
+     * @brief Stateless standard allocator taking its memory from the thread caching slab pools
+     * @details Meant for node based containers and small buffers. Allocations larger than 4 KiB go to operator new
+     */
+    template<typename T>
+    class SlabAllocator {
+    public:
+        using value_type = T;
+
+        constexpr SlabAllocator() noexcept = default;
+
+        template<typename U>
+        constexpr SlabAllocator(const SlabAllocator<U> &) noexcept { }
+
+        [[nodiscard]] T* allocate(size_t count) {
+            if (count > size_t(-1) / sizeof(T))
+                throw std::bad_array_new_length();
+
+            return static_cast<T*>(detail::allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *pointer, size_t count) noexcept {
+            detail::deallocate(pointer, count * sizeof(T), alignof(T));
+        }
+
+        template<typename U>
+        constexpr bool operator==(const SlabAllocator<U> &) const noexcept {
+            return true;
+        }
+    };
+
+    /**
+     * @brief Memory resource taking its memory from the thread caching slab pools
+     * @details All instances share the same pools. Unlike most memory resources it's thread safe
+     */
+    class SlabResource : public std::pmr::memory_resource {
+    public:
+        /**
+         * @brief Returns the number of bytes all slab pools together have requested from the system
+         */
+        [[nodiscard]] static size_t getBytesReserved() {
+            return detail::slabBytesReserved(std::make_index_sequence<detail::SlabClassCount>());
+        }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            return detail::allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override {
+            detail::deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    /**
+     * @brief Returns a slab resource that lives for the whole duration of the program
+     */
+    inline std::pmr::memory_resource* getSlabResource() {
+        // Intentionally leaked, so it can still be used from destructors of static objects
+        static auto instance = new SlabResource();
+        return instance;
+    }
+
+}
@@ -1,17 +1,32 @@
 #pragma once
 
-namespace wolv::container {
-
-#include <vector>
-#include <stdexcept>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace wolv::container {
 
     template<typename T>
     class RingBuffer {
     public:
-        explicit RingBuffer(std::size_t capacity)
+        /**
+         * @brief Creates a ring buffer
+         * @param capacity Maximum number of elements. The storage behind it is rounded up to the next power of two,
+         *                 so indices can be wrapped with a mask instead of a division
+         * @param resource Memory resource to allocate the storage from
+         */
+        explicit RingBuffer(std::size_t capacity, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
             : m_capacity(capacity),
-              m_buffer(capacity)
+              m_buffer(capacity == 0 ? 0 : std::bit_ceil(capacity), resource),
+              m_mask(m_buffer.size() - 1)
         {
             if (capacity == 0) {
                 throw std::invalid_argument("Capacity must be greater than zero");
@@ -20,32 +35,117 @@ namespace wolv::container {
 
         bool push(const T& item) {
             if (full()) {
-                m_tail = (m_tail + 1) % m_capacity; // overwrite oldest
+                m_tail = wrap(m_tail + 1); // overwrite oldest
+                --m_size;
             }
             m_buffer[m_head] = item;
-            m_head = (m_head + 1) % m_capacity;
-            if (m_size < m_capacity) ++m_size;
+            m_head = wrap(m_head + 1);
+            ++m_size;
             return true;
         }
 
         bool push(T&& item) {
             if (full()) {
-                m_tail = (m_tail + 1) % m_capacity;
+                m_tail = wrap(m_tail + 1);
+                --m_size;
             }
             m_buffer[m_head] = std::move(item);
-            m_head = (m_head + 1) % m_capacity;
-            if (m_size < m_capacity) ++m_size;
+            m_head = wrap(m_head + 1);
+            ++m_size;
             return true;
         }
 
         bool pop(T& out) {
             if (empty()) return false;
             out = std::move(m_buffer[m_tail]);
-            m_tail = (m_tail + 1) % m_capacity;
+            m_tail = wrap(m_tail + 1);
             --m_size;
             return true;
         }
 
+        /**
+         * @brief Appends as many elements of a span as there is free space for
+         * @note Unlike push(), this never overwrites elements that haven't been read yet. Trivially copyable elements
+         *       are copied with at most two memcpy calls
+         * @param items Elements to append
+         * @return Number of elements that were appended
+         */
+        std::size_t pushSpan(std::span<const T> items) {
+            const auto count = std::min(items.size(), m_capacity - m_size);
+            const auto regions = writableRegions();
+
+            const auto first = std::min(count, regions[0].size());
+            copy(items.first(first), regions[0].data());
+            copy(items.subspan(first, count - first), regions[1].data());
+
+            commitWrite(count);
+            return count;
+        }
+
+        /**
+         * @brief Removes elements from the front of the buffer and moves them into a span
+         * @note Trivially copyable elements are copied with at most two memcpy calls
+         * @param out Span to fill
+         * @return Number of elements that were removed
+         */
+        std::size_t popSpan(std::span<T> out) {
+            const auto count = std::min(out.size(), m_size);
+            const auto regions = readableRegions();
+
+            const auto first = std::min(count, regions[0].size());
+            move(regions[0].first(first), out.data());
+            move(regions[1].first(count - first), out.data() + first);
+
+            consume(count);
+            return count;
+        }
+
+        /**
+         * @brief Returns the stored elements as up to two contiguous spans, oldest first
+         * @details The second span is only non-empty if the elements wrap around the end of the storage. Call consume()
+         *          after processing elements to remove them from the buffer
+         */
+        std::array<std::span<T>, 2> readableRegions() noexcept {
+            const auto first = std::min(m_size, m_buffer.size() - m_tail);
+            return { std::span<T>(m_buffer.data() + m_tail, first), std::span<T>(m_buffer.data(), m_size - first) };
+        }
+
+        std::array<std::span<const T>, 2> readableRegions() const noexcept {
+            const auto first = std::min(m_size, m_buffer.size() - m_tail);
+            return { std::span<const T>(m_buffer.data() + m_tail, first), std::span<const T>(m_buffer.data(), m_size - first) };
+        }
+
+        /**
+         * @brief Returns the free space of the buffer as up to two contiguous spans, in the order they get filled
+         * @details Write elements into the spans directly, for example by reading from a file or socket into them,
+         *          then call commitWrite() with the number of elements written
+         */
+        std::array<std::span<T>, 2> writableRegions() noexcept {
+            const auto free = m_capacity - m_size;
+            const auto first = std::min(free, m_buffer.size() - m_head);
+            return { std::span<T>(m_buffer.data() + m_head, first), std::span<T>(m_buffer.data(), free - first) };
+        }
+
+        /**
+         * @brief Appends elements that have been written into the writable regions
+         * @param count Number of elements written, at most the combined size of the writable regions
+         */
+        void commitWrite(std::size_t count) {
+            if (count > m_capacity - m_size) throw std::out_of_range("RingBuffer write exceeds free space");
+            m_head = wrap(m_head + count);
+            m_size += count;
+        }
+
+        /**
+         * @brief Removes elements from the front of the buffer without reading them
+         * @param count Number of elements to remove, at most size()
+         */
+        void consume(std::size_t count) {
+            if (count > m_size) throw std::out_of_range("RingBuffer consume exceeds size");
+            m_tail = wrap(m_tail + count);
+            m_size -= count;
+        }
+
         bool empty() const noexcept {
             return m_size == 0;
         }
@@ -66,109 +166,131 @@ namespace wolv::container {
             m_head = m_tail = m_size = 0;
         }
 
-    T& front() {
-        if (empty()) throw std::out_of_range("RingBuffer is empty");
-        return m_buffer[m_tail];
-    }
-
-    const T& front() const {
-        if (empty()) throw std::out_of_range("RingBuffer is empty");
-        return m_buffer[m_tail];
-    }
-
-    T& back() {
-        if (empty()) throw std::out_of_range("RingBuffer is empty");
-        return m_buffer[(m_head + m_capacity - 1) % m_capacity];
-    }
-
-    const T& back() const {
-        if (empty()) throw std::out_of_range("RingBuffer is empty");
-        return m_buffer[(m_head + m_capacity - 1) % m_capacity];
-    }
-
-    // ---- Iterator support ----
-    class iterator {
-    public:
-        using iterator_category = std::forward_iterator_tag;
-        using value_type = T;
-        using difference_type = std::ptrdiff_t;
-        using pointer = T*;
-        using reference = T&;
-
-        iterator(RingBuffer* buf, std::size_t pos, std::size_t count)
-            : m_buf(buf), m_pos(pos), m_remaining(count) {}
-
-        reference operator*() { return m_buf->m_buffer[m_pos]; }
-        pointer operator->() { return &m_buf->m_buffer[m_pos]; }
+        T& front() {
+            if (empty()) throw std::out_of_range("RingBuffer is empty");
+            return m_buffer[m_tail];
+        }
 
-        iterator& operator++() {
-            m_pos = (m_pos + 1) % m_buf->m_capacity;
-            --m_remaining;
-            return *this;
+        const T& front() const {
+            if (empty()) throw std::out_of_range("RingBuffer is empty");
+            return m_buffer[m_tail];
         }
 
-        bool operator==(const iterator& other) const {
-            return m_remaining == other.m_remaining;
+        T& back() {
+            if (empty()) throw std::out_of_range("RingBuffer is empty");
+            return m_buffer[wrap(m_head - 1)];
         }
 
-        bool operator!=(const iterator& other) const {
-            return !(*this == other);
+        const T& back() const {
+            if (empty()) throw std::out_of_range("RingBuffer is empty");
+            return m_buffer[wrap(m_head - 1)];
         }
 
-    private:
-        RingBuffer* m_buf;
-        std::size_t m_pos;
-        std::size_t m_remaining;
-    };
+        // ---- Iterator support ----
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+
+            iterator(RingBuffer* buf, std::size_t pos, std::size_t count)
+                : m_buf(buf), m_pos(pos), m_remaining(count) {}
+
+            reference operator*() { return m_buf->m_buffer[m_pos]; }
+            pointer operator->() { return &m_buf->m_buffer[m_pos]; }
+
+            iterator& operator++() {
+                m_pos = m_buf->wrap(m_pos + 1);
+                --m_remaining;
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const {
+                return m_remaining == other.m_remaining;
+            }
 
-    iterator begin() { return iterator(this, m_tail, m_size); }
-    iterator end() { return iterator(this, 0, 0); }
+            bool operator!=(const iterator& other) const {
+                return !(*this == other);
+            }
 
-    // ---- Const iterator ----
-    class const_iterator {
-    public:
-        using iterator_category = std::forward_iterator_tag;
-        using value_type = const T;
-        using difference_type = std::ptrdiff_t;
-        using pointer = const T*;
-        using reference = const T&;
+        private:
+            RingBuffer* m_buf;
+            std::size_t m_pos;
+            std::size_t m_remaining;
+        };
+
+        iterator begin() { return iterator(this, m_tail, m_size); }
+        iterator end() { return iterator(this, 0, 0); }
+
+        // ---- Const iterator ----
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = const T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            const_iterator(const RingBuffer* buf, std::size_t pos, std::size_t count)
+                : m_buf(buf), m_pos(pos), m_remaining(count) {}
+
+            reference operator*() const { return m_buf->m_buffer[m_pos]; }
+            pointer operator->() const { return &m_buf->m_buffer[m_pos]; }
+
+            const_iterator& operator++() {
+                m_pos = m_buf->wrap(m_pos + 1);
+                --m_remaining;
+                return *this;
+            }
+
+            bool operator==(const const_iterator& other) const {
+                return m_remaining == other.m_remaining;
+            }
 
-        const_iterator(const RingBuffer* buf, std::size_t pos, std::size_t count)
-            : m_buf(buf), m_pos(pos), m_remaining(count) {}
+            bool operator!=(const const_iterator& other) const {
+                return !(*this == other);
+            }
 
-        reference operator*() const { return m_buf->m_buffer[m_pos]; }
-        pointer operator->() const { return &m_buf->m_buffer[m_pos]; }
+        private:
+            const RingBuffer* m_buf;
+            std::size_t m_pos;
+            std::size_t m_remaining;
+        };
 
-        const_iterator& operator++() {
-            m_pos = (m_pos + 1) % m_buf->m_capacity;
-            --m_remaining;
-            return *this;
-        }
+        const_iterator begin() const { return const_iterator(this, m_tail, m_size); }
+        const_iterator end() const { return const_iterator(this, 0, 0); }
 
-        bool operator==(const const_iterator& other) const {
-            return m_remaining == other.m_remaining;
+    private:
+        std::size_t wrap(std::size_t index) const noexcept {
+            return index & m_mask;
         }
 
-        bool operator!=(const const_iterator& other) const {
-            return !(*this == other);
+        static void copy(std::span<const T> from, T* to) {
+            if (from.empty()) return;
+
+            if constexpr (std::is_trivially_copyable_v<T>)
+                std::memcpy(to, from.data(), from.size_bytes());
+            else
+                std::copy(from.begin(), from.end(), to);
         }
 
-    private:
-        const RingBuffer* m_buf;
-        std::size_t m_pos;
-        std::size_t m_remaining;
-    };
+        static void move(std::span<T> from, T* to) {
+            if (from.empty()) return;
 
-    const_iterator begin() const { return const_iterator(this, m_tail, m_size); }
-    const_iterator end() const { return const_iterator(this, 0, 0); }
+            if constexpr (std::is_trivially_copyable_v<T>)
+                std::memcpy(to, from.data(), from.size_bytes());
+            else
+                std::move(from.begin(), from.end(), to);
+        }
 
-    private:
         std::size_t m_capacity;
-        std::vector<T> m_buffer;
+        std::pmr::vector<T> m_buffer;
+        std::size_t m_mask;
         std::size_t m_head = 0;
         std::size_t m_tail = 0;
         std::size_t m_size = 0;
     };
 
-
-}
\ No newline at end of file
+}
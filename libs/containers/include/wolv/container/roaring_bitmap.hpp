@@ -0,0 +1,998 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define WOLV_ROARING_SSE2
+#endif
+
+namespace wolv::container {
+
+    namespace detail {
+
+        // Number of 64 bit words of a bitmap container covering one chunk of 65536 values
+        inline constexpr size_t RoaringBitmapWords = 1024;
+
+        enum class RoaringOperation {
+            Or,
+            And,
+            AndNot
+        };
+
+        /**
+         * @brief Combines two bitmap containers word by word and returns the cardinality of the result
+         * @details Uses 128 bit SSE2 operations where available, the following population count is left to the compiler,
+         *          which turns it into popcnt instructions if the target supports them
+         */
+        template<RoaringOperation Operation>
+        inline u32 roaringCombine(u64 *destination, const u64 *source) {
+            #if defined(WOLV_ROARING_SSE2)
+                for (size_t i = 0; i < RoaringBitmapWords; i += 2) {
+                    const auto left  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+                    const auto right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+
+                    __m128i result;
+                    if constexpr (Operation == RoaringOperation::Or)
+                        result = _mm_or_si128(left, right);
+                    else if constexpr (Operation == RoaringOperation::And)
+                        result = _mm_and_si128(left, right);
+                    else
+                        result = _mm_andnot_si128(right, left);
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), result);
+                }
+            #else
+                for (size_t i = 0; i < RoaringBitmapWords; i += 1) {
+                    if constexpr (Operation == RoaringOperation::Or)
+                        destination[i] |= source[i];
+                    else if constexpr (Operation == RoaringOperation::And)
+                        destination[i] &= source[i];
+                    else
+                        destination[i] &= ~source[i];
+                }
+            #endif
+
+            u32 cardinality = 0;
+            for (size_t i = 0; i < RoaringBitmapWords; i += 1)
+                cardinality += u32(std::popcount(destination[i]));
+
+            return cardinality;
+        }
+
+    }
+
+    /**
+     * @brief Compressed set of 64 bit integers in the style of a roaring bitmap
+     * @details Values are split into chunks of 65536 by their upper bits. Every chunk that contains at least one value
+     *          is stored in the container that's smallest for its contents: a sorted array for up to 4096 values, a plain
+     *          bitmap of 8 KiB for dense chunks, or a list of runs for chunks made of long consecutive ranges. Set
+     *          operations work chunk by chunk and use word wise SIMD operations for bitmaps, so even sets spanning
+     *          billions of values only take memory in proportion to how fragmented they are
+     */
+    class RoaringBitmap {
+    public:
+        RoaringBitmap() = default;
+
+        RoaringBitmap(std::initializer_list<u64> values) {
+            for (const auto value : values)
+                this->add(value);
+        }
+
+        /**
+         * @brief Adds a value to the set
+         * @return True if the value wasn't in the set yet
+         */
+        bool add(u64 value) {
+            const auto index = this->findOrCreate(value >> 16);
+            return this->m_containers[index].add(u16(value));
+        }
+
+        /**
+         * @brief Removes a value from the set
+         * @return True if the value was in the set
+         */
+        bool remove(u64 value) {
+            const auto index = this->find(value >> 16);
+            if (index == NotFound)
+                return false;
+
+            const auto removed = this->m_containers[index].remove(u16(value));
+            if (this->m_containers[index].cardinality == 0)
+                this->eraseContainer(index);
+
+            return removed;
+        }
+
+        /**
+         * @brief Adds all values from start to end, inclusive
+         * @details Chunks inside the range are merged in place. Every chunk touched by the range needs a container of its
+         *          own, so time and memory grow with the number of chunks the range spans
+         * @throws std::length_error if the range spans more chunks than can be stored. The set is left unchanged then
+         */
+        void addRange(u64 start, u64 end) {
+            if (start > end)
+                return;
+
+            const auto firstKey = start >> 16, lastKey = end >> 16;
+            const auto begin = size_t(std::lower_bound(this->m_keys.begin(), this->m_keys.end(), firstKey) - this->m_keys.begin());
+            const auto existingEnd = size_t(std::upper_bound(this->m_keys.begin() + begin, this->m_keys.end(), lastKey) - this->m_keys.begin());
+
+            const u64 missing = (lastKey - firstKey + 1) - (existingEnd - begin);
+            if (missing > std::min(this->m_keys.max_size(), this->m_containers.max_size()) - this->m_keys.size())
+                throw std::length_error("RoaringBitmap range spans too many chunks");
+
+            // Make room for the missing chunks behind the existing ones, then fill the range in from the back so every
+            // existing container gets moved to its final position before its old slot is overwritten
+            this->m_keys.insert(this->m_keys.begin() + existingEnd, size_t(missing), 0);
+            this->m_containers.insert(this->m_containers.begin() + existingEnd, size_t(missing), Container());
+
+            auto read = existingEnd, write = existingEnd + size_t(missing);
+            for (u64 key = lastKey; ; key -= 1) {
+                const auto run = chunkRun(key, start, end);
+                const bool fullChunk = run.start == 0x0000 && run.end == 0xFFFF;
+
+                write -= 1;
+                if (read > begin && this->m_keys[read - 1] == key) {
+                    read -= 1;
+                    this->m_containers[write] = fullChunk ? Container::fromRuns({ run }) : Container::unite(this->m_containers[read], Container::fromRuns({ run }));
+                } else {
+                    this->m_containers[write] = Container::fromRuns({ run });
+                }
+                this->m_keys[write] = key;
+
+                if (key == firstKey)
+                    break;
+            }
+        }
+
+        /**
+         * @brief Removes all values from start to end, inclusive
+         * @details Only visits the chunks of the set that overlap the range, no matter how large the range is
+         */
+        void removeRange(u64 start, u64 end) {
+            if (start > end)
+                return;
+
+            const auto firstKey = start >> 16, lastKey = end >> 16;
+            const auto begin = size_t(std::lower_bound(this->m_keys.begin(), this->m_keys.end(), firstKey) - this->m_keys.begin());
+
+            // Keep the chunks that still hold values after the removal at the front and erase the rest in one go
+            auto write = begin, read = begin;
+            for (; read < this->m_keys.size() && this->m_keys[read] <= lastKey; read += 1) {
+                const auto key = this->m_keys[read];
+                const auto run = chunkRun(key, start, end);
+                if (run.start == 0x0000 && run.end == 0xFFFF)
+                    continue;
+
+                auto container = Container::subtract(this->m_containers[read], Container::fromRuns({ run }));
+                if (container.cardinality == 0)
+                    continue;
+
+                this->m_keys[write] = key;
+                this->m_containers[write] = std::move(container);
+                write += 1;
+            }
+
+            this->m_keys.erase(this->m_keys.begin() + write, this->m_keys.begin() + read);
+            this->m_containers.erase(this->m_containers.begin() + write, this->m_containers.begin() + read);
+        }
+
+        [[nodiscard]] bool contains(u64 value) const {
+            const auto index = this->find(value >> 16);
+            return index != NotFound && this->m_containers[index].contains(u16(value));
+        }
+
+        /**
+         * @brief Returns the number of values in the set
+         */
+        [[nodiscard]] u64 cardinality() const {
+            u64 result = 0;
+            for (const auto &container : this->m_containers)
+                result += container.cardinality;
+
+            return result;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return this->m_containers.empty();
+        }
+
+        void clear() {
+            this->m_keys.clear();
+            this->m_containers.clear();
+        }
+
+        /**
+         * @brief Returns the number of values in the set that are smaller than or equal to the given value
+         */
+        [[nodiscard]] u64 rank(u64 value) const {
+            const auto key = value >> 16;
+
+            u64 result = 0;
+            for (size_t index = 0; index < this->m_keys.size() && this->m_keys[index] <= key; index += 1) {
+                if (this->m_keys[index] < key)
+                    result += this->m_containers[index].cardinality;
+                else
+                    result += this->m_containers[index].rank(u16(value));
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Returns the value at the given position of the sorted set
+         * @param index Zero based position, select(0) is the smallest value
+         * @return The value or std::nullopt if the set has fewer values
+         */
+        [[nodiscard]] std::optional<u64> select(u64 index) const {
+            for (size_t i = 0; i < this->m_containers.size(); i += 1) {
+                const auto &container = this->m_containers[i];
+                if (index < container.cardinality)
+                    return (this->m_keys[i] << 16) | container.select(u32(index));
+
+                index -= container.cardinality;
+            }
+
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Calls a callback for every value in ascending order
+         * @param callback Callable taking a u64. If it returns a bool, returning false stops the iteration
+         */
+        template<typename Callback>
+        void forEach(Callback &&callback) const {
+            this->forEachRange([&callback](u64 start, u64 end) {
+                for (u64 value = start; ; value += 1) {
+                    if constexpr (std::is_void_v<std::invoke_result_t<Callback&, u64>>) {
+                        callback(value);
+                    } else {
+                        if (!static_cast<bool>(callback(value)))
+                            return false;
+                    }
+
+                    if (value == end)
+                        return true;
+                }
+            });
+        }
+
+        /**
+         * @brief Calls a callback for every range of consecutive values in ascending order
+         * @param callback Callable taking the first and the last value of the range. If it returns a bool, returning
+         *                 false stops the iteration
+         */
+        template<typename Callback>
+        void forEachRange(Callback &&callback) const {
+            const auto invoke = [&callback](u64 start, u64 end) {
+                if constexpr (std::is_void_v<std::invoke_result_t<Callback&, u64, u64>>) {
+                    callback(start, end);
+                    return true;
+                } else {
+                    return static_cast<bool>(callback(start, end));
+                }
+            };
+
+            // Ranges are joined across chunk boundaries, so a range is only reported once it's known to be complete
+            std::optional<std::pair<u64, u64>> pending;
+            for (size_t i = 0; i < this->m_containers.size(); i += 1) {
+                const auto base = this->m_keys[i] << 16;
+
+                const bool completed = this->m_containers[i].forEachRange([&](u32 start, u32 end) {
+                    if (pending.has_value() && pending->second + 1 == base + start) {
+                        pending->second = base + end;
+                        return true;
+                    }
+
+                    if (pending.has_value() && !invoke(pending->first, pending->second))
+                        return false;
+
+                    pending = { base + start, base + end };
+                    return true;
+                });
+
+                if (!completed)
+                    return;
+            }
+
+            if (pending.has_value())
+                invoke(pending->first, pending->second);
+        }
+
+        /**
+         * @brief Converts every chunk to the representation that uses the least memory
+         * @details Chunks created through addRange() already use runs. Call this after adding many consecutive values
+         *          one by one, to turn them into runs as well
+         */
+        void optimize() {
+            for (auto &container : this->m_containers)
+                container.optimize();
+        }
+
+        /**
+         * @brief Returns the approximate number of bytes used by the set
+         */
+        [[nodiscard]] size_t getMemoryUsage() const {
+            size_t result = sizeof(*this) + this->m_keys.capacity() * sizeof(u64) + this->m_containers.capacity() * sizeof(Container);
+            for (const auto &container : this->m_containers)
+                result += container.getMemoryUsage();
+
+            return result;
+        }
+
+        RoaringBitmap& operator|=(const RoaringBitmap &other) {
+            RoaringBitmap result;
+            result.reserve(this->m_keys.size() + other.m_keys.size());
+
+            size_t left = 0, right = 0;
+            while (left < this->m_keys.size() || right < other.m_keys.size()) {
+                if (right == other.m_keys.size() || (left < this->m_keys.size() && this->m_keys[left] < other.m_keys[right])) {
+                    result.append(this->m_keys[left], std::move(this->m_containers[left]));
+                    left += 1;
+                } else if (left == this->m_keys.size() || other.m_keys[right] < this->m_keys[left]) {
+                    result.append(other.m_keys[right], Container(other.m_containers[right]));
+                    right += 1;
+                } else {
+                    result.append(this->m_keys[left], Container::unite(this->m_containers[left], other.m_containers[right]));
+                    left += 1;
+                    right += 1;
+                }
+            }
+
+            return *this = std::move(result);
+        }
+
+        RoaringBitmap& operator&=(const RoaringBitmap &other) {
+            RoaringBitmap result;
+
+            size_t left = 0, right = 0;
+            while (left < this->m_keys.size() && right < other.m_keys.size()) {
+                if (this->m_keys[left] < other.m_keys[right]) {
+                    left += 1;
+                } else if (other.m_keys[right] < this->m_keys[left]) {
+                    right += 1;
+                } else {
+                    auto container = Container::intersect(this->m_containers[left], other.m_containers[right]);
+                    if (container.cardinality > 0)
+                        result.append(this->m_keys[left], std::move(container));
+
+                    left += 1;
+                    right += 1;
+                }
+            }
+
+            return *this = std::move(result);
+        }
+
+        RoaringBitmap& operator-=(const RoaringBitmap &other) {
+            RoaringBitmap result;
+            result.reserve(this->m_keys.size());
+
+            size_t right = 0;
+            for (size_t left = 0; left < this->m_keys.size(); left += 1) {
+                while (right < other.m_keys.size() && other.m_keys[right] < this->m_keys[left])
+                    right += 1;
+
+                if (right < other.m_keys.size() && other.m_keys[right] == this->m_keys[left]) {
+                    auto container = Container::subtract(this->m_containers[left], other.m_containers[right]);
+                    if (container.cardinality > 0)
+                        result.append(this->m_keys[left], std::move(container));
+                } else {
+                    result.append(this->m_keys[left], std::move(this->m_containers[left]));
+                }
+            }
+
+            return *this = std::move(result);
+        }
+
+        [[nodiscard]] friend RoaringBitmap operator|(RoaringBitmap left, const RoaringBitmap &right) {
+            return left |= right;
+        }
+
+        [[nodiscard]] friend RoaringBitmap operator&(RoaringBitmap left, const RoaringBitmap &right) {
+            return left &= right;
+        }
+
+        [[nodiscard]] friend RoaringBitmap operator-(RoaringBitmap left, const RoaringBitmap &right) {
+            return left -= right;
+        }
+
+        [[nodiscard]] bool operator==(const RoaringBitmap &other) const {
+            return this->m_keys == other.m_keys && std::equal(this->m_containers.begin(), this->m_containers.end(), other.m_containers.begin());
+        }
+
+    private:
+        constexpr static size_t NotFound = ~size_t(0);
+
+        // Array containers holding more values than this are turned into bitmaps, which have a fixed size of 8 KiB
+        constexpr static u32 MaxArraySize = 4096;
+
+        /**
+         * @brief Run of consecutive values inside a chunk, both ends inclusive
+         */
+        struct Run {
+            u16 start, end;
+
+            bool operator==(const Run &other) const = default;
+        };
+
+        /**
+         * @brief Values of a single chunk of 65536
+         */
+        struct Container {
+            enum class Kind : u8 {
+                Array,
+                Bitmap,
+                Run
+            };
+
+            Kind kind = Kind::Array;
+            u32 cardinality = 0;
+
+            std::vector<u16> values;
+            std::vector<u64> words;
+            std::vector<Run> runs;
+
+            [[nodiscard]] bool contains(u16 value) const {
+                switch (this->kind) {
+                    case Kind::Array:
+                        return std::binary_search(this->values.begin(), this->values.end(), value);
+                    case Kind::Bitmap:
+                        return (this->words[value / 64] >> (value % 64)) & 1;
+                    case Kind::Run: {
+                        const auto run = this->findRun(value);
+                        return run != this->runs.end() && run->start <= value;
+                    }
+                }
+
+                return false;
+            }
+
+            bool add(u16 value) {
+                switch (this->kind) {
+                    case Kind::Array: {
+                        const auto iter = std::lower_bound(this->values.begin(), this->values.end(), value);
+                        if (iter != this->values.end() && *iter == value)
+                            return false;
+
+                        this->values.insert(iter, value);
+                        this->cardinality += 1;
+
+                        if (this->cardinality > MaxArraySize)
+                            this->toBitmap();
+
+                        return true;
+                    }
+                    case Kind::Bitmap: {
+                        auto &word = this->words[value / 64];
+                        const auto bit = u64(1) << (value % 64);
+                        if (word & bit)
+                            return false;
+
+                        word |= bit;
+                        this->cardinality += 1;
+                        return true;
+                    }
+                    case Kind::Run: {
+                        auto run = this->findRun(value);
+                        if (run != this->runs.end() && run->start <= value)
+                            return false;
+
+                        // Extend the neighbouring runs if the value touches them, otherwise start a new one
+                        const bool extendsPrevious = run != this->runs.begin() && std::prev(run)->end + 1 == value;
+                        const bool extendsNext = run != this->runs.end() && run->start == value + 1;
+
+                        if (extendsPrevious && extendsNext) {
+                            std::prev(run)->end = run->end;
+                            this->runs.erase(run);
+                        } else if (extendsPrevious) {
+                            std::prev(run)->end = value;
+                        } else if (extendsNext) {
+                            run->start = value;
+                        } else {
+                            this->runs.insert(run, { value, value });
+                        }
+
+                        this->cardinality += 1;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            bool remove(u16 value) {
+                switch (this->kind) {
+                    case Kind::Array: {
+                        const auto iter = std::lower_bound(this->values.begin(), this->values.end(), value);
+                        if (iter == this->values.end() || *iter != value)
+                            return false;
+
+                        this->values.erase(iter);
+                        this->cardinality -= 1;
+                        return true;
+                    }
+                    case Kind::Bitmap: {
+                        auto &word = this->words[value / 64];
+                        const auto bit = u64(1) << (value % 64);
+                        if (!(word & bit))
+                            return false;
+
+                        word &= ~bit;
+                        this->cardinality -= 1;
+
+                        if (this->cardinality <= MaxArraySize)
+                            this->toArray();
+
+                        return true;
+                    }
+                    case Kind::Run: {
+                        const auto run = this->findRun(value);
+                        if (run == this->runs.end() || run->start > value)
+                            return false;
+
+                        if (run->start == run->end) {
+                            this->runs.erase(run);
+                        } else if (run->start == value) {
+                            run->start += 1;
+                        } else if (run->end == value) {
+                            run->end -= 1;
+                        } else {
+                            const Run tail = { u16(value + 1), run->end };
+                            run->end = u16(value - 1);
+                            this->runs.insert(std::next(run), tail);
+                        }
+
+                        this->cardinality -= 1;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            /**
+             * @brief Returns the number of values smaller than or equal to the given value
+             */
+            [[nodiscard]] u32 rank(u16 value) const {
+                switch (this->kind) {
+                    case Kind::Array:
+                        return u32(std::upper_bound(this->values.begin(), this->values.end(), value) - this->values.begin());
+                    case Kind::Bitmap: {
+                        u32 result = 0;
+                        for (size_t i = 0; i < value / 64u; i += 1)
+                            result += u32(std::popcount(this->words[i]));
+
+                        const auto bits = value % 64u;
+                        const auto mask = bits == 63 ? ~u64(0) : (u64(1) << (bits + 1)) - 1;
+                        return result + u32(std::popcount(this->words[value / 64] & mask));
+                    }
+                    case Kind::Run: {
+                        u32 result = 0;
+                        for (const auto &run : this->runs) {
+                            if (run.start > value)
+                                break;
+
+                            result += u32(std::min(run.end, value)) - run.start + 1;
+                        }
+
+                        return result;
+                    }
+                }
+
+                return 0;
+            }
+
+            /**
+             * @brief Returns the value at the given position, which has to be smaller than the cardinality
+             */
+            [[nodiscard]] u16 select(u32 index) const {
+                switch (this->kind) {
+                    case Kind::Array:
+                        return this->values[index];
+                    case Kind::Bitmap:
+                        for (size_t i = 0; i < detail::RoaringBitmapWords; i += 1) {
+                            auto word = this->words[i];
+                            const auto count = u32(std::popcount(word));
+                            if (index >= count) {
+                                index -= count;
+                                continue;
+                            }
+
+                            for (; index > 0; index -= 1)
+                                word &= word - 1;
+
+                            return u16(i * 64 + std::countr_zero(word));
+                        }
+                        break;
+                    case Kind::Run:
+                        for (const auto &run : this->runs) {
+                            const u32 length = u32(run.end) - run.start + 1;
+                            if (index < length)
+                                return u16(run.start + index);
+
+                            index -= length;
+                        }
+                        break;
+                }
+
+                return 0;
+            }
+
+            /**
+             * @brief Calls a callback for every range of consecutive values, returning false from it stops the iteration
+             * @return False if the iteration got stopped
+             */
+            template<typename Callback>
+            bool forEachRange(Callback &&callback) const {
+                switch (this->kind) {
+                    case Kind::Array:
+                        for (size_t i = 0; i < this->values.size(); ) {
+                            size_t last = i;
+                            while (last + 1 < this->values.size() && this->values[last + 1] == this->values[last] + 1)
+                                last += 1;
+
+                            if (!callback(u32(this->values[i]), u32(this->values[last])))
+                                return false;
+
+                            i = last + 1;
+                        }
+                        break;
+                    case Kind::Bitmap:
+                        for (u32 position = this->nextBit(0, true); position < 0x10000; ) {
+                            const auto end = this->nextBit(position, false);
+                            if (!callback(position, end - 1))
+                                return false;
+
+                            position = this->nextBit(end, true);
+                        }
+                        break;
+                    case Kind::Run:
+                        for (const auto &run : this->runs) {
+                            if (!callback(u32(run.start), u32(run.end)))
+                                return false;
+                        }
+                        break;
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Switches to the representation that uses the least memory
+             */
+            void optimize() {
+                u32 runCount = 0;
+                this->forEachRange([&runCount](u32, u32) { runCount += 1; return true; });
+
+                const auto runSize = runCount * sizeof(Run);
+                const auto otherSize = this->cardinality <= MaxArraySize ? this->cardinality * sizeof(u16) : detail::RoaringBitmapWords * sizeof(u64);
+
+                if (runSize < otherSize)
+                    this->toRuns();
+                else if (this->cardinality <= MaxArraySize)
+                    this->toArray();
+                else
+                    this->toBitmap();
+            }
+
+            [[nodiscard]] size_t getMemoryUsage() const {
+                return this->values.capacity() * sizeof(u16) + this->words.capacity() * sizeof(u64) + this->runs.capacity() * sizeof(Run);
+            }
+
+            [[nodiscard]] bool operator==(const Container &other) const {
+                if (this->cardinality != other.cardinality)
+                    return false;
+                if (this->kind == other.kind && this->kind == Kind::Array)
+                    return this->values == other.values;
+                if (this->kind == other.kind && this->kind == Kind::Bitmap)
+                    return this->words == other.words;
+
+                return this->toRunList() == other.toRunList();
+            }
+
+            [[nodiscard]] static Container unite(const Container &left, const Container &right) {
+                if (left.kind == Kind::Run && right.kind == Kind::Run)
+                    return fromRuns(uniteRuns(left.runs, right.runs));
+
+                if (left.kind == Kind::Array && right.kind == Kind::Array) {
+                    Container result;
+                    result.values.reserve(left.values.size() + right.values.size());
+                    std::set_union(left.values.begin(), left.values.end(), right.values.begin(), right.values.end(), std::back_inserter(result.values));
+                    result.cardinality = u32(result.values.size());
+
+                    if (result.cardinality > MaxArraySize)
+                        result.toBitmap();
+
+                    return result;
+                }
+
+                auto result = fromWords(left.toWords(), right.toWords(), detail::roaringCombine<detail::RoaringOperation::Or>);
+                if (left.kind == Kind::Run || right.kind == Kind::Run)
+                    result.optimize();
+
+                return result;
+            }
+
+            [[nodiscard]] static Container intersect(const Container &left, const Container &right) {
+                if (left.kind == Kind::Array || right.kind == Kind::Array) {
+                    const auto &array = left.kind == Kind::Array ? left : right;
+                    const auto &other = left.kind == Kind::Array ? right : left;
+
+                    Container result;
+                    for (const auto value : array.values) {
+                        if (other.contains(value))
+                            result.values.push_back(value);
+                    }
+                    result.cardinality = u32(result.values.size());
+
+                    return result;
+                }
+
+                if (left.kind == Kind::Run && right.kind == Kind::Run)
+                    return fromRuns(intersectRuns(left.runs, right.runs));
+
+                return fromWords(left.toWords(), right.toWords(), detail::roaringCombine<detail::RoaringOperation::And>);
+            }
+
+            [[nodiscard]] static Container subtract(const Container &left, const Container &right) {
+                if (left.kind == Kind::Array) {
+                    Container result;
+                    for (const auto value : left.values) {
+                        if (!right.contains(value))
+                            result.values.push_back(value);
+                    }
+                    result.cardinality = u32(result.values.size());
+
+                    return result;
+                }
+
+                if (left.kind == Kind::Run && right.kind == Kind::Run)
+                    return fromRuns(subtractRuns(left.runs, right.runs));
+
+                auto result = fromWords(left.toWords(), right.toWords(), detail::roaringCombine<detail::RoaringOperation::AndNot>);
+                if (left.kind == Kind::Run)
+                    result.optimize();
+
+                return result;
+            }
+
+            [[nodiscard]] static Container fromRuns(std::vector<Run> runs) {
+                Container result;
+                result.kind = Kind::Run;
+                for (const auto &run : runs)
+                    result.cardinality += u32(run.end) - run.start + 1;
+                result.runs = std::move(runs);
+
+                // Heavily fragmented results are better off in one of the other representations
+                if (result.runs.size() * sizeof(Run) >= std::min<size_t>(result.cardinality * sizeof(u16), detail::RoaringBitmapWords * sizeof(u64)))
+                    result.optimize();
+
+                return result;
+            }
+
+        private:
+            /**
+             * @brief Returns the first run that ends at or after the value
+             */
+            [[nodiscard]] std::vector<Run>::iterator findRun(u16 value) {
+                return std::lower_bound(this->runs.begin(), this->runs.end(), value, [](const Run &run, u16 value) { return run.end < value; });
+            }
+
+            [[nodiscard]] std::vector<Run>::const_iterator findRun(u16 value) const {
+                return std::lower_bound(this->runs.begin(), this->runs.end(), value, [](const Run &run, u16 value) { return run.end < value; });
+            }
+
+            /**
+             * @brief Returns the position of the next set or clear bit at or after the given position, or 65536 if there's none
+             */
+            [[nodiscard]] u32 nextBit(u32 position, bool set) const {
+                while (position < 0x10000) {
+                    auto word = set ? this->words[position / 64] : ~this->words[position / 64];
+                    word &= ~u64(0) << (position % 64);
+
+                    if (word != 0)
+                        return (position & ~63u) + u32(std::countr_zero(word));
+
+                    position = (position & ~63u) + 64;
+                }
+
+                return 0x10000;
+            }
+
+            [[nodiscard]] std::vector<Run> toRunList() const {
+                std::vector<Run> result;
+                this->forEachRange([&result](u32 start, u32 end) {
+                    result.push_back({ u16(start), u16(end) });
+                    return true;
+                });
+
+                return result;
+            }
+
+            [[nodiscard]] std::vector<u64> toWords() const {
+                if (this->kind == Kind::Bitmap)
+                    return this->words;
+
+                std::vector<u64> result(detail::RoaringBitmapWords);
+                this->forEachRange([&result](u32 start, u32 end) {
+                    for (u32 word = start / 64; word <= end / 64; word += 1) {
+                        const auto first = std::max(start, word * 64) % 64;
+                        const auto last = std::min(end, word * 64 + 63) % 64;
+                        const auto mask = (last == 63 ? ~u64(0) : (u64(1) << (last + 1)) - 1) & (~u64(0) << first);
+
+                        result[word] |= mask;
+                    }
+                    return true;
+                });
+
+                return result;
+            }
+
+            template<typename Combine>
+            [[nodiscard]] static Container fromWords(std::vector<u64> left, const std::vector<u64> &right, Combine &&combine) {
+                Container result;
+                result.kind = Kind::Bitmap;
+                result.cardinality = combine(left.data(), right.data());
+                result.words = std::move(left);
+
+                if (result.cardinality <= MaxArraySize)
+                    result.toArray();
+
+                return result;
+            }
+
+            void toArray() {
+                if (this->kind == Kind::Array)
+                    return;
+
+                std::vector<u16> values;
+                values.reserve(this->cardinality);
+                this->forEachRange([&values](u32 start, u32 end) {
+                    for (u32 value = start; value <= end; value += 1)
+                        values.push_back(u16(value));
+                    return true;
+                });
+
+                *this = { Kind::Array, this->cardinality, std::move(values), { }, { } };
+            }
+
+            void toBitmap() {
+                if (this->kind == Kind::Bitmap)
+                    return;
+
+                *this = { Kind::Bitmap, this->cardinality, { }, this->toWords(), { } };
+            }
+
+            void toRuns() {
+                if (this->kind == Kind::Run)
+                    return;
+
+                *this = { Kind::Run, this->cardinality, { }, { }, this->toRunList() };
+            }
+
+            [[nodiscard]] static std::vector<Run> uniteRuns(const std::vector<Run> &left, const std::vector<Run> &right) {
+                std::vector<Run> result;
+                result.reserve(left.size() + right.size());
+
+                size_t leftIndex = 0, rightIndex = 0;
+                while (leftIndex < left.size() || rightIndex < right.size()) {
+                    const auto &next = rightIndex == right.size() || (leftIndex < left.size() && left[leftIndex].start < right[rightIndex].start)
+                                           ? left[leftIndex++]
+                                           : right[rightIndex++];
+
+                    if (!result.empty() && u32(result.back().end) + 1 >= next.start)
+                        result.back().end = std::max(result.back().end, next.end);
+                    else
+                        result.push_back(next);
+                }
+
+                return result;
+            }
+
+            [[nodiscard]] static std::vector<Run> intersectRuns(const std::vector<Run> &left, const std::vector<Run> &right) {
+                std::vector<Run> result;
+
+                size_t leftIndex = 0, rightIndex = 0;
+                while (leftIndex < left.size() && rightIndex < right.size()) {
+                    const auto start = std::max(left[leftIndex].start, right[rightIndex].start);
+                    const auto end = std::min(left[leftIndex].end, right[rightIndex].end);
+                    if (start <= end)
+                        result.push_back({ start, end });
+
+                    if (left[leftIndex].end < right[rightIndex].end)
+                        leftIndex += 1;
+                    else
+                        rightIndex += 1;
+                }
+
+                return result;
+            }
+
+            [[nodiscard]] static std::vector<Run> subtractRuns(const std::vector<Run> &left, const std::vector<Run> &right) {
+                std::vector<Run> result;
+
+                size_t rightIndex = 0;
+                for (const auto &run : left) {
+                    u32 start = run.start;
+
+                    while (rightIndex < right.size() && right[rightIndex].end < start)
+                        rightIndex += 1;
+
+                    for (auto index = rightIndex; index < right.size() && right[index].start <= run.end; index += 1) {
+                        if (right[index].start > start)
+                            result.push_back({ u16(start), u16(right[index].start - 1) });
+
+                        start = u32(right[index].end) + 1;
+                    }
+
+                    if (start <= run.end)
+                        result.push_back({ u16(start), run.end });
+                }
+
+                return result;
+            }
+        };
+
+        /**
+         * @brief Returns the part of the range from start to end that lies inside the chunk with the given key
+         */
+        [[nodiscard]] static Run chunkRun(u64 key, u64 start, u64 end) {
+            return {
+                key == (start >> 16) ? u16(start) : u16(0x0000),
+                key == (end >> 16)   ? u16(end)   : u16(0xFFFF)
+            };
+        }
+
+        [[nodiscard]] size_t find(u64 key) const {
+            const auto iter = std::lower_bound(this->m_keys.begin(), this->m_keys.end(), key);
+            if (iter == this->m_keys.end() || *iter != key)
+                return NotFound;
+
+            return size_t(iter - this->m_keys.begin());
+        }
+
+        size_t findOrCreate(u64 key) {
+            const auto iter = std::lower_bound(this->m_keys.begin(), this->m_keys.end(), key);
+            const auto index = size_t(iter - this->m_keys.begin());
+
+            if (iter == this->m_keys.end() || *iter != key) {
+                this->m_keys.insert(iter, key);
+                this->m_containers.insert(this->m_containers.begin() + index, Container());
+            }
+
+            return index;
+        }
+
+        void eraseContainer(size_t index) {
+            this->m_keys.erase(this->m_keys.begin() + index);
+            this->m_containers.erase(this->m_containers.begin() + index);
+        }
+
+        void append(u64 key, Container &&container) {
+            this->m_keys.push_back(key);
+            this->m_containers.push_back(std::move(container));
+        }
+
+        void reserve(size_t count) {
+            this->m_keys.reserve(count);
+            this->m_containers.reserve(count);
+        }
+
+        // Upper 48 bits of the values of each chunk and their containers, sorted by key
+        std::vector<u64> m_keys;
+        std::vector<Container> m_containers;
+    };
+
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace wolv::container {
+
+    /**
+     * @brief A vector that stores up to N elements inline and only allocates once it grows past that
+     * @details Behaves like std::vector for the common operations, but holding a handful of elements never touches the
+     *          heap. That makes it a good fit for short lists that get created and destroyed all the time, like the
+     *          arguments of a function call or the parts of a split string. Once the inline capacity is exceeded, the
+     *          elements are moved to the heap and the vector grows geometrically like std::vector does
+     * @note Unlike std::vector, moving a SmallVector that still uses its inline storage moves the elements one by one,
+     *       so iterators into the source are not carried over
+     * @tparam T The element type
+     * @tparam N Number of elements that fit into the inline storage
+     */
+    template<typename T, size_t N>
+    class SmallVector {
+        static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+
+    public:
+        using value_type             = T;
+        using size_type              = size_t;
+        using difference_type        = std::ptrdiff_t;
+        using reference              = T&;
+        using const_reference        = const T&;
+        using pointer                = T*;
+        using const_pointer          = const T*;
+        using iterator               = T*;
+        using const_iterator         = const T*;
+        using reverse_iterator       = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        SmallVector() noexcept = default;
+
+        explicit SmallVector(size_t count) {
+            this->resize(count);
+        }
+
+        SmallVector(size_t count, const T &value) {
+            this->resize(count, value);
+        }
+
+        SmallVector(std::initializer_list<T> init) {
+            this->assign(init.begin(), init.end());
+        }
+
+        template<std::input_iterator Iterator>
+        SmallVector(Iterator first, Iterator last) {
+            this->assign(first, last);
+        }
+
+        SmallVector(const SmallVector &other) {
+            this->assign(other.begin(), other.end());
+        }
+
+        SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            this->takeFrom(std::move(other));
+        }
+
+        ~SmallVector() {
+            this->clear();
+            this->deallocate();
+        }
+
+        SmallVector& operator=(const SmallVector &other) {
+            if (this != &other)
+                this->assign(other.begin(), other.end());
+
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (this != &other) {
+                this->clear();
+                this->deallocate();
+                this->takeFrom(std::move(other));
+            }
+
+            return *this;
+        }
+
+        SmallVector& operator=(std::initializer_list<T> init) {
+            this->assign(init.begin(), init.end());
+
+            return *this;
+        }
+
+        /**
+         * @brief Replaces the contents with the elements of a range
+         */
+        template<std::input_iterator Iterator>
+        void assign(Iterator first, Iterator last) {
+            this->clear();
+
+            if constexpr (std::forward_iterator<Iterator>)
+                this->reserve(size_t(std::distance(first, last)));
+
+            for (; first != last; ++first)
+                this->emplace_back(*first);
+        }
+
+        [[nodiscard]] T& operator[](size_t index) noexcept { return this->m_data[index]; }
+        [[nodiscard]] const T& operator[](size_t index) const noexcept { return this->m_data[index]; }
+
+        [[nodiscard]] T& at(size_t index) {
+            if (index >= this->m_size)
+                throw std::out_of_range("SmallVector index out of range");
+
+            return this->m_data[index];
+        }
+
+        [[nodiscard]] const T& at(size_t index) const {
+            if (index >= this->m_size)
+                throw std::out_of_range("SmallVector index out of range");
+
+            return this->m_data[index];
+        }
+
+        [[nodiscard]] T& front() noexcept { return this->m_data[0]; }
+        [[nodiscard]] const T& front() const noexcept { return this->m_data[0]; }
+        [[nodiscard]] T& back() noexcept { return this->m_data[this->m_size - 1]; }
+        [[nodiscard]] const T& back() const noexcept { return this->m_data[this->m_size - 1]; }
+
+        [[nodiscard]] T* data() noexcept { return this->m_data; }
+        [[nodiscard]] const T* data() const noexcept { return this->m_data; }
+
+        [[nodiscard]] iterator begin() noexcept { return this->m_data; }
+        [[nodiscard]] const_iterator begin() const noexcept { return this->m_data; }
+        [[nodiscard]] const_iterator cbegin() const noexcept { return this->m_data; }
+        [[nodiscard]] iterator end() noexcept { return this->m_data + this->m_size; }
+        [[nodiscard]] const_iterator end() const noexcept { return this->m_data + this->m_size; }
+        [[nodiscard]] const_iterator cend() const noexcept { return this->m_data + this->m_size; }
+
+        [[nodiscard]] reverse_iterator rbegin() noexcept { return reverse_iterator(this->end()); }
+        [[nodiscard]] const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(this->end()); }
+        [[nodiscard]] reverse_iterator rend() noexcept { return reverse_iterator(this->begin()); }
+        [[nodiscard]] const_reverse_iterator rend() const noexcept { return const_reverse_iterator(this->begin()); }
+
+        [[nodiscard]] bool empty() const noexcept { return this->m_size == 0; }
+        [[nodiscard]] size_t size() const noexcept { return this->m_size; }
+        [[nodiscard]] size_t capacity() const noexcept { return this->m_capacity; }
+
+        /**
+         * @brief Checks if the elements are still stored inline
+         */
+        [[nodiscard]] bool isInline() const noexcept { return this->m_data == this->inlineData(); }
+
+        /**
+         * @brief Makes sure the vector can hold at least the given number of elements without reallocating
+         */
+        void reserve(size_t capacity) {
+            if (capacity > this->m_capacity)
+                this->reallocate(capacity);
+        }
+
+        void resize(size_t count) {
+            this->resizeImpl(count, [this] { this->emplace_back(); });
+        }
+
+        void resize(size_t count, const T &value) {
+            this->resizeImpl(count, [this, &value] { this->emplace_back(value); });
+        }
+
+        void clear() noexcept {
+            std::destroy(this->begin(), this->end());
+            this->m_size = 0;
+        }
+
+        void push_back(const T &value) {
+            this->emplace_back(value);
+        }
+
+        void push_back(T &&value) {
+            this->emplace_back(std::move(value));
+        }
+
+        template<typename ... Args>
+        T& emplace_back(Args && ... args) {
+            if (this->m_size < this->m_capacity) {
+                std::construct_at(this->m_data + this->m_size, std::forward<Args>(args)...);
+                this->m_size += 1;
+
+                return this->back();
+            }
+
+            // Construct the new element before moving the old ones, the arguments may refer to one of them
+            const auto capacity = this->m_capacity * 2;
+            T *data = std::allocator<T>().allocate(capacity);
+            try {
+                std::construct_at(data + this->m_size, std::forward<Args>(args)...);
+            } catch (...) {
+                std::allocator<T>().deallocate(data, capacity);
+                throw;
+            }
+
+            this->moveTo(data, capacity);
+            this->m_size += 1;
+
+            return this->back();
+        }
+
+        void pop_back() noexcept {
+            this->m_size -= 1;
+            std::destroy_at(this->m_data + this->m_size);
+        }
+
+        template<typename ... Args>
+        iterator emplace(const_iterator position, Args && ... args) {
+            const auto index = size_t(position - this->begin());
+
+            this->emplace_back(std::forward<Args>(args)...);
+            std::rotate(this->begin() + index, this->end() - 1, this->end());
+
+            return this->begin() + index;
+        }
+
+        iterator insert(const_iterator position, const T &value) {
+            return this->emplace(position, value);
+        }
+
+        iterator insert(const_iterator position, T &&value) {
+            return this->emplace(position, std::move(value));
+        }
+
+        iterator erase(const_iterator position) {
+            return this->erase(position, position + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            const auto begin = this->begin() + (first - this->begin());
+            const auto end   = this->begin() + (last - this->begin());
+
+            if (begin != end) {
+                const auto newEnd = std::move(end, this->end(), begin);
+                std::destroy(newEnd, this->end());
+                this->m_size = size_t(newEnd - this->begin());
+            }
+
+            return begin;
+        }
+
+        template<size_t OtherN>
+        [[nodiscard]] bool operator==(const SmallVector<T, OtherN> &other) const {
+            return std::equal(this->begin(), this->end(), other.begin(), other.end());
+        }
+
+    private:
+        [[nodiscard]] T* inlineData() noexcept { return reinterpret_cast<T*>(this->m_inline); }
+        [[nodiscard]] const T* inlineData() const noexcept { return reinterpret_cast<const T*>(this->m_inline); }
+
+        template<typename Append>
+        void resizeImpl(size_t count, Append &&append) {
+            if (count < this->m_size) {
+                std::destroy(this->begin() + count, this->end());
+                this->m_size = count;
+            } else {
+                this->reserve(count);
+                while (this->m_size < count)
+                    append();
+            }
+        }
+
+        void reallocate(size_t capacity) {
+            this->moveTo(std::allocator<T>().allocate(capacity), capacity);
+        }
+
+        /**
+         * @brief Moves all elements to new heap storage and releases the old one
+         */
+        void moveTo(T *data, size_t capacity) {
+            std::uninitialized_move(this->begin(), this->end(), data);
+            std::destroy(this->begin(), this->end());
+            this->deallocate();
+
+            this->m_data = data;
+            this->m_capacity = capacity;
+        }
+
+        void deallocate() noexcept {
+            if (!this->isInline())
+                std::allocator<T>().deallocate(this->m_data, this->m_capacity);
+
+            this->m_data = this->inlineData();
+            this->m_capacity = N;
+        }
+
+        void takeFrom(SmallVector &&other) {
+            if (other.isInline()) {
+                std::uninitialized_move(other.begin(), other.end(), this->m_data);
+                this->m_size = other.m_size;
+                other.clear();
+            } else {
+                this->m_data     = std::exchange(other.m_data, other.inlineData());
+                this->m_size     = std::exchange(other.m_size, 0);
+                this->m_capacity = std::exchange(other.m_capacity, N);
+            }
+        }
+
+        alignas(T) std::byte m_inline[N * sizeof(T)];
+        T *m_data = inlineData();
+        size_t m_size = 0, m_capacity = N;
+    };
+
+}
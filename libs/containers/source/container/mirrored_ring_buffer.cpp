@@ -0,0 +1,107 @@
+#include <wolv/container/mirrored_ring_buffer.hpp>
+
+#include <atomic>
+#include <string>
+
+#if defined(OS_WINDOWS)
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #include <fcntl.h>
+#endif
+
+namespace wolv::container {
+
+    size_t MirroredRingBuffer::allocationGranularity() {
+        #if defined(OS_WINDOWS)
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return info.dwAllocationGranularity;
+        #else
+            return size_t(sysconf(_SC_PAGESIZE));
+        #endif
+    }
+
+    u8* MirroredRingBuffer::createMirroredMapping(size_t size) {
+        #if defined(OS_WINDOWS)
+            const auto mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, DWORD(u64(size) >> 32), DWORD(size), nullptr);
+            if (mapping == nullptr)
+                return nullptr;
+
+            // Find a free address range large enough for both views, then map them into it. Another thread may grab
+            // the range in between, so retry a couple of times
+            u8 *result = nullptr;
+            for (u32 attempt = 0; attempt < 16 && result == nullptr; attempt += 1) {
+                auto address = static_cast<u8*>(VirtualAlloc(nullptr, size * 2, MEM_RESERVE, PAGE_NOACCESS));
+                if (address == nullptr)
+                    break;
+                VirtualFree(address, 0, MEM_RELEASE);
+
+                const auto first = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, address);
+                if (first == nullptr)
+                    continue;
+
+                const auto second = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, address + size);
+                if (second == nullptr) {
+                    UnmapViewOfFile(first);
+                    continue;
+                }
+
+                result = address;
+            }
+
+            // The views keep the mapping alive on their own
+            CloseHandle(mapping);
+            return result;
+        #else
+            #if defined(OS_LINUX)
+                const int fd = memfd_create("wolv-ring-buffer", MFD_CLOEXEC);
+            #else
+                static std::atomic<u32> counter = 0;
+                const auto name = "/wolv-ring-buffer-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+                const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+                if (fd != -1)
+                    shm_unlink(name.c_str());
+            #endif
+
+            if (fd == -1)
+                return nullptr;
+
+            u8 *result = nullptr;
+            if (ftruncate(fd, off_t(size)) == 0) {
+                // Reserve the whole range first so nothing else can end up between the two mappings
+                auto address = static_cast<u8*>(mmap(nullptr, size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+                if (address != MAP_FAILED) {
+                    const bool mapped =
+                        mmap(address,        size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+                        mmap(address + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+
+                    if (mapped)
+                        result = address;
+                    else
+                        munmap(address, size * 2);
+                }
+            }
+
+            // The mappings keep the memory alive on their own
+            close(fd);
+            return result;
+        #endif
+    }
+
+    void MirroredRingBuffer::release() noexcept {
+        if (this->m_data == nullptr)
+            return;
+
+        #if defined(OS_WINDOWS)
+            UnmapViewOfFile(this->m_data);
+            UnmapViewOfFile(this->m_data + this->m_capacity);
+        #else
+            munmap(this->m_data, this->m_capacity * 2);
+        #endif
+
+        this->m_data = nullptr;
+    }
+
+}
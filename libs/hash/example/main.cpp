@@ -1,4 +1,5 @@
 #include <wolv/hash/crc.hpp>
+#include <wolv/hash/sha256.hpp>
 #include <wolv/hash/uuid.hpp>
 
 #include <cstdio>
@@ -15,7 +16,17 @@ int main() {
     crc32.process(data.begin(), data.end());
     printf("CRC32: %08llX\n", crc32.getResult());
 
+    wolv::hash::Sha256 sha256;
+    sha256.process(data);
+    printf("SHA256: ");
+    for (auto byte : sha256.getResult())
+        printf("%02X", byte);
+    printf("\n");
+
     auto uuid = wolv::hash::generateUUID();
     printf("UUID: %s\n", uuid.c_str());
 
+    auto uuidV7 = wolv::hash::Uuid::generateV7();
+    printf("UUIDv7: %s\n", uuidV7.toString().c_str());
+
 }
\ No newline at end of file
@@ -0,0 +1,470 @@
+#pragma once
+
+#include <wolv/types.hpp>
+#include <wolv/hash/detail/cpu.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <optional>
+#include <span>
+
+namespace wolv::hash {
+
+    namespace detail {
+
+        /**
+         * @brief Result of the byte sum kernels
+         * @details For bytes d[0..n-1], sum is the sum of all d[i] and weightedSum is the sum of all (n - i) * d[i].
+         *          These two values are enough to advance any Fletcher-style checksum by n bytes
+         */
+        struct ByteSums {
+            u64 sum;
+            u64 weightedSum;
+        };
+
+        // Largest input the byte sum kernels accept at once without their 32 bit lanes overflowing
+        constexpr static size_t MaxByteSumsSize = 8192;
+
+        inline ByteSums byteSumsScalar(const u8 *data, size_t size) {
+            u64 sum = 0, weightedSum = 0;
+            for (size_t i = 0; i < size; i++) {
+                sum += data[i];
+                weightedSum += sum;
+            }
+
+            return { sum, weightedSum };
+        }
+
+        inline u64 byteSumScalar(const u8 *data, size_t size) {
+            u64 sum = 0;
+            for (size_t i = 0; i < size; i++)
+                sum += data[i];
+
+            return sum;
+        }
+
+        inline u8 byteXorScalar(const u8 *data, size_t size) {
+            u8 result = 0;
+            for (size_t i = 0; i < size; i++)
+                result ^= data[i];
+
+            return result;
+        }
+
+        // Appends the sums of the bytes following a block to the sums of the block itself
+        constexpr ByteSums appendByteSums(ByteSums block, ByteSums tail, size_t tailSize) {
+            return { block.sum + tail.sum, block.weightedSum + tailSize * block.sum + tail.weightedSum };
+        }
+
+        #if defined(WOLV_HASH_ARCH_X86)
+
+            template<typename Vector>
+            inline u64 horizontalSum32(const Vector &vector) {
+                std::array<u32, sizeof(Vector) / sizeof(u32)> lanes;
+                std::memcpy(lanes.data(), &vector, sizeof(vector));
+
+                u64 result = 0;
+                for (auto lane : lanes)
+                    result += lane;
+
+                return result;
+            }
+
+            WOLV_HASH_TARGET("avx2") inline ByteSums byteSumsAvx2(const u8 *data, size_t size) {
+                const auto zero    = _mm256_setzero_si256();
+                const auto ones    = _mm256_set1_epi16(1);
+                const auto weights = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                                                      16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1);
+
+                auto sums = zero, prefixSums = zero, weightedSums = zero;
+
+                const auto blockCount = size / 32;
+                for (size_t i = 0; i < blockCount; i++) {
+                    const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 32));
+
+                    // Every previous block's sum gets weighted by 32 more for each block that follows it
+                    prefixSums   = _mm256_add_epi32(prefixSums, sums);
+                    sums         = _mm256_add_epi32(sums, _mm256_sad_epu8(bytes, zero));
+                    weightedSums = _mm256_add_epi32(weightedSums, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, weights), ones));
+                }
+
+                const ByteSums blocks = { horizontalSum32(sums), horizontalSum32(weightedSums) + 32 * horizontalSum32(prefixSums) };
+                const auto tailSize = size - blockCount * 32;
+
+                return appendByteSums(blocks, byteSumsScalar(data + blockCount * 32, tailSize), tailSize);
+            }
+
+            WOLV_HASH_TARGET("ssse3") inline ByteSums byteSumsSsse3(const u8 *data, size_t size) {
+                const auto zero    = _mm_setzero_si128();
+                const auto ones    = _mm_set1_epi16(1);
+                const auto weights = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+
+                auto sums = zero, prefixSums = zero, weightedSums = zero;
+
+                const auto blockCount = size / 16;
+                for (size_t i = 0; i < blockCount; i++) {
+                    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+
+                    prefixSums   = _mm_add_epi32(prefixSums, sums);
+                    sums         = _mm_add_epi32(sums, _mm_sad_epu8(bytes, zero));
+                    weightedSums = _mm_add_epi32(weightedSums, _mm_madd_epi16(_mm_maddubs_epi16(bytes, weights), ones));
+                }
+
+                const ByteSums blocks = { horizontalSum32(sums), horizontalSum32(weightedSums) + 16 * horizontalSum32(prefixSums) };
+                const auto tailSize = size - blockCount * 16;
+
+                return appendByteSums(blocks, byteSumsScalar(data + blockCount * 16, tailSize), tailSize);
+            }
+
+            WOLV_HASH_TARGET("avx2") inline u64 byteSumAvx2(const u8 *data, size_t size) {
+                auto sums = _mm256_setzero_si256();
+
+                const auto blockCount = size / 32;
+                for (size_t i = 0; i < blockCount; i++) {
+                    const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 32));
+                    sums = _mm256_add_epi64(sums, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+                }
+
+                std::array<u64, 4> lanes;
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.data()), sums);
+
+                return lanes[0] + lanes[1] + lanes[2] + lanes[3] + byteSumScalar(data + blockCount * 32, size - blockCount * 32);
+            }
+
+            WOLV_HASH_TARGET("ssse3") inline u64 byteSumSsse3(const u8 *data, size_t size) {
+                auto sums = _mm_setzero_si128();
+
+                const auto blockCount = size / 16;
+                for (size_t i = 0; i < blockCount; i++) {
+                    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+                    sums = _mm_add_epi64(sums, _mm_sad_epu8(bytes, _mm_setzero_si128()));
+                }
+
+                std::array<u64, 2> lanes;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.data()), sums);
+
+                return lanes[0] + lanes[1] + byteSumScalar(data + blockCount * 16, size - blockCount * 16);
+            }
+
+            WOLV_HASH_TARGET("avx2") inline u8 byteXorAvx2(const u8 *data, size_t size) {
+                auto result = _mm256_setzero_si256();
+
+                const auto blockCount = size / 32;
+                for (size_t i = 0; i < blockCount; i++)
+                    result = _mm256_xor_si256(result, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 32)));
+
+                std::array<u8, 32> lanes;
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.data()), result);
+
+                return byteXorScalar(lanes.data(), lanes.size()) ^ byteXorScalar(data + blockCount * 32, size - blockCount * 32);
+            }
+
+            WOLV_HASH_TARGET("ssse3") inline u8 byteXorSsse3(const u8 *data, size_t size) {
+                auto result = _mm_setzero_si128();
+
+                const auto blockCount = size / 16;
+                for (size_t i = 0; i < blockCount; i++)
+                    result = _mm_xor_si128(result, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)));
+
+                std::array<u8, 16> lanes;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.data()), result);
+
+                return byteXorScalar(lanes.data(), lanes.size()) ^ byteXorScalar(data + blockCount * 16, size - blockCount * 16);
+            }
+
+        #endif
+
+        struct ChecksumKernels {
+            ByteSums (*byteSums)(const u8 *data, size_t size);
+            u64 (*byteSum)(const u8 *data, size_t size);
+            u8 (*byteXor)(const u8 *data, size_t size);
+        };
+
+        /**
+         * @brief Returns the fastest checksum kernels supported by the current CPU
+         */
+        inline const ChecksumKernels& getChecksumKernels() {
+            static const ChecksumKernels kernels = []() -> ChecksumKernels {
+                #if defined(WOLV_HASH_ARCH_X86)
+                    const auto &features = getCpuFeatures();
+                    if (features.avx2)
+                        return { byteSumsAvx2, byteSumAvx2, byteXorAvx2 };
+                    if (features.ssse3)
+                        return { byteSumsSsse3, byteSumSsse3, byteXorSsse3 };
+                #endif
+
+                return { byteSumsScalar, byteSumScalar, byteXorScalar };
+            }();
+
+            return kernels;
+        }
+
+        /**
+         * @brief Shared implementation of the byte oriented Fletcher-style checksums (Adler-32 and Fletcher-16)
+         * @tparam Modulus Modulus both running sums are reduced by
+         * @tparam Shift Position of the second sum in the result
+         */
+        template<u32 Modulus, u32 Shift>
+        class FletcherByteChecksum {
+        public:
+            constexpr FletcherByteChecksum(u32 initialSum1) : m_initialSum1(initialSum1) {
+                this->reset();
+            }
+
+            constexpr void reset() {
+                this->m_sum1 = this->m_initialSum1;
+                this->m_sum2 = 0;
+            }
+
+            void process(std::span<const u8> bytes) {
+                const auto &kernels = getChecksumKernels();
+
+                while (!bytes.empty()) {
+                    const auto block = bytes.first(std::min(bytes.size(), MaxByteSumsSize));
+                    const auto sums = kernels.byteSums(block.data(), block.size());
+
+                    this->m_sum2 = u32((this->m_sum2 + block.size() * u64(this->m_sum1) + sums.weightedSum) % Modulus);
+                    this->m_sum1 = u32((this->m_sum1 + sums.sum) % Modulus);
+
+                    bytes = bytes.subspan(block.size());
+                }
+            }
+
+            void process(auto begin, auto end) {
+                this->process({ begin, end });
+            }
+
+            [[nodiscard]]
+            constexpr u32 getResult() const {
+                return (this->m_sum2 << Shift) | this->m_sum1;
+            }
+
+        protected:
+            /**
+             * @brief Computes the checksum of two concatenated blocks of data from the checksums of the individual blocks
+             * @param first Checksum of the first block
+             * @param second Checksum of the second block
+             * @param secondSize Size of the second block in bytes
+             * @return Checksum of the concatenated data
+             */
+            constexpr static u32 combine(u32 first, u32 second, u64 secondSize, u32 initialSum1) {
+                constexpr u32 Mask = (1U << Shift) - 1;
+
+                const u64 size = secondSize % Modulus;
+                const u64 firstSum1  = first & Mask,  firstSum2  = first >> Shift;
+                const u64 secondSum1 = second & Mask, secondSum2 = second >> Shift;
+
+                // The second block's sums were started with initialSum1 instead of the first block's sum1
+                const auto sum1 = (firstSum1 + secondSum1 + Modulus - initialSum1) % Modulus;
+                const auto sum2 = (firstSum2 + secondSum2 + size * firstSum1 + Modulus - (size * initialSum1) % Modulus) % Modulus;
+
+                return u32((sum2 << Shift) | sum1);
+            }
+
+        private:
+            u32 m_initialSum1;
+            u32 m_sum1 = 0, m_sum2 = 0;
+        };
+
+    }
+
+    /**
+     * @brief Adler-32 checksum as used by zlib
+     */
+    class Adler32 : public detail::FletcherByteChecksum<65521, 16> {
+    public:
+        constexpr Adler32() : FletcherByteChecksum(1) { }
+
+        constexpr static u32 combine(u32 first, u32 second, u64 secondSize) {
+            return FletcherByteChecksum::combine(first, second, secondSize, 1);
+        }
+    };
+
+    /**
+     * @brief Fletcher-16 checksum over 8 bit values
+     */
+    class Fletcher16 : public detail::FletcherByteChecksum<255, 8> {
+    public:
+        constexpr Fletcher16() : FletcherByteChecksum(0) { }
+
+        constexpr static u32 combine(u32 first, u32 second, u64 secondSize) {
+            return FletcherByteChecksum::combine(first, second, secondSize, 0);
+        }
+    };
+
+    /**
+     * @brief Fletcher-32 checksum over 16 bit values
+     * @note If the input has an odd length, it is padded with a zero byte when retrieving the result
+     */
+    class Fletcher32 {
+    public:
+        constexpr static u32 Modulus = 65535;
+
+        /**
+         * @brief Creates a new Fletcher-32 checksum
+         * @param endian Byte order of the 16 bit values in the input
+         */
+        constexpr explicit Fletcher32(std::endian endian = std::endian::little) : m_endian(endian) {
+            this->reset();
+        }
+
+        constexpr void reset() {
+            this->m_sum1 = 0;
+            this->m_sum2 = 0;
+            this->m_pendingByte.reset();
+        }
+
+        constexpr void process(std::span<const u8> bytes) {
+            if (bytes.empty())
+                return;
+
+            if (this->m_pendingByte.has_value()) {
+                const u8 word[2] = { *this->m_pendingByte, bytes[0] };
+                this->m_pendingByte.reset();
+                this->processWords(word, 1);
+                bytes = bytes.subspan(1);
+            }
+
+            this->processWords(bytes.data(), bytes.size() / 2);
+
+            if (bytes.size() % 2 != 0)
+                this->m_pendingByte = bytes.back();
+        }
+
+        constexpr void process(auto begin, auto end) {
+            this->process({ begin, end });
+        }
+
+        [[nodiscard]]
+        constexpr u32 getResult() const {
+            if (this->m_pendingByte.has_value()) {
+                auto copy = *this;
+                const u8 word[2] = { *this->m_pendingByte, 0x00 };
+                copy.m_pendingByte.reset();
+                copy.processWords(word, 1);
+
+                return copy.getResult();
+            }
+
+            return (this->m_sum2 << 16) | this->m_sum1;
+        }
+
+        /**
+         * @brief Computes the checksum of two concatenated blocks of data from the checksums of the individual blocks
+         * @param first Checksum of the first block. The first block needs to have an even length
+         * @param second Checksum of the second block
+         * @param secondSize Size of the second block in bytes
+         * @return Checksum of the concatenated data
+         */
+        constexpr static u32 combine(u32 first, u32 second, u64 secondSize) {
+            const u64 words = ((secondSize + 1) / 2) % Modulus;
+
+            const u64 sum1 = ((first & 0xFFFF) + (second & 0xFFFF)) % Modulus;
+            const u64 sum2 = ((first >> 16) + (second >> 16) + words * (first & 0xFFFF)) % Modulus;
+
+            return u32((sum2 << 16) | sum1);
+        }
+
+    private:
+        constexpr void processWords(const u8 *data, size_t wordCount) {
+            // Reduce in blocks small enough for the 64 bit sums to never overflow
+            constexpr size_t BlockSize = 0x10000;
+
+            while (wordCount > 0) {
+                const auto count = std::min(wordCount, BlockSize);
+
+                u64 sum1 = this->m_sum1, sum2 = this->m_sum2;
+                for (size_t i = 0; i < count; i++) {
+                    const u16 word = this->m_endian == std::endian::little
+                            ? u16(data[i * 2] | (data[i * 2 + 1] << 8))
+                            : u16((data[i * 2] << 8) | data[i * 2 + 1]);
+
+                    sum1 += word;
+                    sum2 += sum1;
+                }
+
+                this->m_sum1 = u32(sum1 % Modulus);
+                this->m_sum2 = u32(sum2 % Modulus);
+
+                data += count * 2;
+                wordCount -= count;
+            }
+        }
+
+    private:
+        std::endian m_endian;
+        u32 m_sum1 = 0, m_sum2 = 0;
+        std::optional<u8> m_pendingByte;
+    };
+
+    /**
+     * @brief Simple additive checksum summing up all bytes, truncated to NumBits
+     * @tparam NumBits Width of the checksum
+     */
+    template<size_t NumBits> requires (NumBits > 0 && NumBits <= 64)
+    class AdditiveChecksum {
+    public:
+        constexpr static u64 Mask = NumBits == 64 ? ~u64(0) : (u64(1) << NumBits) - 1;
+
+        constexpr AdditiveChecksum() = default;
+
+        constexpr void reset() {
+            this->m_value = 0;
+        }
+
+        void process(std::span<const u8> bytes) {
+            this->m_value += detail::getChecksumKernels().byteSum(bytes.data(), bytes.size());
+        }
+
+        void process(auto begin, auto end) {
+            this->process({ begin, end });
+        }
+
+        [[nodiscard]]
+        constexpr u64 getResult() const {
+            return this->m_value & Mask;
+        }
+
+        constexpr static u64 combine(u64 first, u64 second) {
+            return (first + second) & Mask;
+        }
+
+    private:
+        u64 m_value = 0;
+    };
+
+    /**
+     * @brief Simple checksum XORing all bytes together
+     */
+    class XorChecksum {
+    public:
+        constexpr XorChecksum() = default;
+
+        constexpr void reset() {
+            this->m_value = 0;
+        }
+
+        void process(std::span<const u8> bytes) {
+            this->m_value ^= detail::getChecksumKernels().byteXor(bytes.data(), bytes.size());
+        }
+
+        void process(auto begin, auto end) {
+            this->process({ begin, end });
+        }
+
+        [[nodiscard]]
+        constexpr u8 getResult() const {
+            return this->m_value;
+        }
+
+        constexpr static u8 combine(u8 first, u8 second) {
+            return first ^ second;
+        }
+
+    private:
+        u8 m_value = 0;
+    };
+
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <wolv/types.hpp>
+#include <wolv/hash/rolling_hash.hpp>
+#include <wolv/hash/detail/source.hpp>
+#include <wolv/hash/sha256.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace wolv::hash {
+
+    /**
+     * @brief Content-defined chunker based on FastCDC
+     * @details Splits a byte stream into variable sized chunks whose boundaries only depend on the surrounding content,
+     *          so inserting or removing data only changes the chunks around the edit. Every chunk is reported together
+     *          with a strong digest of its content which can be used for deduplication.
+     * @tparam StrongHash Digest used to identify chunks. Needs to provide reset(), process(span) and getResult()
+     */
+    template<typename StrongHash = Sha256>
+    class ContentDefinedChunker {
+    public:
+        using Digest = decltype(std::declval<const StrongHash&>().getResult());
+
+        struct Chunk {
+            u64 offset;
+            u64 size;
+            Digest digest;
+        };
+
+        struct Config {
+            size_t minSize     = 2 * 1024;
+            size_t averageSize = 8 * 1024;
+            size_t maxSize     = 64 * 1024;
+
+            // How strongly chunk sizes are pulled towards averageSize. 0 disables normalized chunking
+            u32 normalizationLevel = 2;
+        };
+
+        using Callback = std::function<void(const Chunk &chunk)>;
+
+        /**
+         * @brief Creates a new chunker
+         * @param callback Function called for every chunk, in stream order
+         * @param config Chunk size parameters
+         */
+        explicit ContentDefinedChunker(Callback callback, Config config = { })
+            : m_callback(std::move(callback)), m_config(config) {
+            this->m_config.minSize     = std::max<size_t>(this->m_config.minSize, 1);
+            this->m_config.averageSize = std::max(this->m_config.averageSize, this->m_config.minSize);
+            this->m_config.maxSize     = std::max(this->m_config.maxSize, this->m_config.averageSize);
+
+            const auto bits = u32(std::bit_width(this->m_config.averageSize) - 1);
+            const auto level = bits > 0 ? std::min(this->m_config.normalizationLevel, bits - 1) : 0;
+
+            // The gear hash mixes the most recent bytes into the low bits, use the high bits for the boundary checks
+            this->m_maskSmall = createMask(bits + level);
+            this->m_maskLarge = createMask(bits - level);
+        }
+
+        /**
+         * @brief Feeds the next part of the stream into the chunker
+         * @param bytes Bytes to process
+         */
+        void process(std::span<const u8> bytes) {
+            while (!bytes.empty()) {
+                const auto [consumed, boundary] = this->findBoundary(bytes);
+
+                this->m_hasher.process(bytes.first(consumed));
+                this->m_chunkSize += consumed;
+                bytes = bytes.subspan(consumed);
+
+                if (boundary)
+                    this->emitChunk();
+            }
+        }
+
+        void process(auto begin, auto end) {
+            this->process({ begin, end });
+        }
+
+        /**
+         * @brief Reads a range of data from a source and feeds it into the chunker
+         * @param source Object providing either readBufferAtomic(address, buffer, size), like wolv::io::File,
+         *               or read(address, buffer, size), like wolv::io::BufferedReader
+         * @param address Address to start reading from
+         * @param size Number of bytes to read
+         * @param bufferSize Size of the intermediate buffer used to read from the source
+         */
+        void process(auto &source, u64 address, u64 size, size_t bufferSize = 0x100000) {
+            std::vector<u8> buffer(std::max<size_t>(std::min<u64>(bufferSize, size), 1));
+
+            while (size > 0) {
+                const auto readSize = size_t(std::min<u64>(buffer.size(), size));
+                const auto bytesRead = detail::readSource(source, address, buffer.data(), readSize);
+                if (bytesRead == 0)
+                    break;
+
+                this->process(std::span(buffer).first(bytesRead));
+                address += bytesRead;
+                size -= bytesRead;
+            }
+        }
+
+        /**
+         * @brief Emits the last, possibly smaller than minSize, chunk and resets the chunker for a new stream
+         */
+        void finish() {
+            if (this->m_chunkSize > 0)
+                this->emitChunk();
+
+            this->m_offset = 0;
+        }
+
+    private:
+        constexpr static u64 createMask(u32 bits) {
+            if (bits == 0)
+                return 0;
+
+            return ~u64(0) << (64 - std::min<u32>(bits, 64));
+        }
+
+        struct BoundaryResult {
+            size_t consumed;
+            bool boundary;
+        };
+
+        BoundaryResult findBoundary(std::span<const u8> bytes) {
+            const auto &config = this->m_config;
+            size_t position = 0;
+
+            // Nothing before minSize can become a boundary so these bytes don't need to be hashed at all
+            if (this->m_chunkSize < config.minSize) {
+                const auto skip = std::min(bytes.size(), config.minSize - this->m_chunkSize);
+                position = skip;
+            }
+
+            auto hash = this->m_hash;
+            for (; position < bytes.size(); position++) {
+                const auto chunkSize = this->m_chunkSize + position;
+                if (chunkSize >= config.maxSize) {
+                    this->m_hash = 0;
+                    return { position, true };
+                }
+
+                hash = (hash << 1) + detail::GearTable[bytes[position]];
+
+                const auto mask = chunkSize < config.averageSize ? this->m_maskSmall : this->m_maskLarge;
+                if ((hash & mask) == 0) {
+                    this->m_hash = 0;
+                    return { position + 1, true };
+                }
+            }
+
+            this->m_hash = hash;
+            return { bytes.size(), false };
+        }
+
+        void emitChunk() {
+            const Chunk chunk = { this->m_offset, this->m_chunkSize, this->m_hasher.getResult() };
+
+            this->m_offset += this->m_chunkSize;
+            this->m_chunkSize = 0;
+            this->m_hash = 0;
+            this->m_hasher.reset();
+
+            this->m_callback(chunk);
+        }
+
+    private:
+        Callback m_callback;
+        Config m_config;
+
+        u64 m_maskSmall = 0, m_maskLarge = 0;
+
+        StrongHash m_hasher;
+        u64 m_hash = 0;
+        u64 m_offset = 0;
+        u64 m_chunkSize = 0;
+    };
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <span>
+
+namespace wolv::hash::detail {
+
+    constexpr u32 loadBE32(const u8 *data) {
+        return (u32(data[0]) << 24) | (u32(data[1]) << 16) | (u32(data[2]) << 8) | u32(data[3]);
+    }
+
+    constexpr u32 loadLE32(const u8 *data) {
+        return u32(data[0]) | (u32(data[1]) << 8) | (u32(data[2]) << 16) | (u32(data[3]) << 24);
+    }
+
+    constexpr void storeBE32(u8 *data, u32 value) {
+        data[0] = u8(value >> 24);
+        data[1] = u8(value >> 16);
+        data[2] = u8(value >> 8);
+        data[3] = u8(value);
+    }
+
+    constexpr void storeLE32(u8 *data, u32 value) {
+        data[0] = u8(value);
+        data[1] = u8(value >> 8);
+        data[2] = u8(value >> 16);
+        data[3] = u8(value >> 24);
+    }
+
+    /**
+     * @brief Streaming front-end shared by the Merkle-Damgård digests (MD5, SHA-1, SHA-256)
+     * @details Buffers partial input blocks and hands all complete blocks to the compression function at once
+     * @tparam Derived Digest providing the InitialState and a static compress(State&, const u8*, size_t blockCount) function
+     * @tparam State Chaining state of the digest
+     * @tparam LengthEndianness Byte order of the message length appended during padding
+     */
+    template<typename Derived, typename State, std::endian LengthEndianness>
+    class BlockDigest {
+    public:
+        constexpr static size_t BlockSize = 64;
+
+        void reset() {
+            this->m_state = Derived::InitialState;
+            this->m_bufferSize = 0;
+            this->m_totalSize = 0;
+        }
+
+        void process(std::span<const u8> bytes) {
+            this->m_totalSize += bytes.size();
+
+            if (this->m_bufferSize > 0) {
+                const auto count = std::min(bytes.size(), BlockSize - this->m_bufferSize);
+                std::copy_n(bytes.begin(), count, this->m_buffer.begin() + this->m_bufferSize);
+                this->m_bufferSize += count;
+                bytes = bytes.subspan(count);
+
+                if (this->m_bufferSize < BlockSize)
+                    return;
+
+                Derived::compress(this->m_state, this->m_buffer.data(), 1);
+                this->m_bufferSize = 0;
+            }
+
+            const auto blockCount = bytes.size() / BlockSize;
+            if (blockCount > 0) {
+                Derived::compress(this->m_state, bytes.data(), blockCount);
+                bytes = bytes.subspan(blockCount * BlockSize);
+            }
+
+            std::ranges::copy(bytes, this->m_buffer.begin());
+            this->m_bufferSize = bytes.size();
+        }
+
+        void process(auto begin, auto end) {
+            this->process({ begin, end });
+        }
+
+    protected:
+        /**
+         * @brief Pads a copy of the current state and compresses the final block(s)
+         * @return Chaining state after all input has been processed
+         */
+        [[nodiscard]] State finalize() const {
+            State state = this->m_state;
+
+            std::array<u8, BlockSize * 2> tail = { };
+            std::copy_n(this->m_buffer.begin(), this->m_bufferSize, tail.begin());
+            tail[this->m_bufferSize] = 0x80;
+
+            const size_t tailSize = (this->m_bufferSize + 1 + sizeof(u64)) <= BlockSize ? BlockSize : BlockSize * 2;
+            const u64 bitCount = this->m_totalSize * 8;
+            for (size_t i = 0; i < sizeof(u64); i++) {
+                const auto shift = LengthEndianness == std::endian::big ? (56 - i * 8) : (i * 8);
+                tail[tailSize - sizeof(u64) + i] = u8(bitCount >> shift);
+            }
+
+            Derived::compress(state, tail.data(), tailSize / BlockSize);
+
+            return state;
+        }
+
+    private:
+        State m_state = { };
+        std::array<u8, BlockSize> m_buffer = { };
+        size_t m_bufferSize = 0;
+        u64 m_totalSize = 0;
+    };
+
+}
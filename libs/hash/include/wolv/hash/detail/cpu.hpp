@@ -0,0 +1,89 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define WOLV_HASH_ARCH_X86
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+
+    #include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define WOLV_HASH_TARGET(features)
+#else
+    #define WOLV_HASH_TARGET(features) __attribute__((target(features)))
+#endif
+
+namespace wolv::hash::detail {
+
+    /**
+     * @brief Instruction set extensions the accelerated hash kernels can make use of
+     */
+    struct CpuFeatures {
+        bool ssse3 = false;
+        bool sse41 = false;
+        bool avx2 = false;
+        bool sha = false;
+    };
+
+    /**
+     * @brief Queries the features of the CPU the program is currently running on
+     * @note The result is determined once and cached for all subsequent calls
+     * @return Supported instruction set extensions
+     */
+    inline const CpuFeatures& getCpuFeatures() {
+        static const CpuFeatures features = [] {
+            CpuFeatures result;
+
+            #if defined(WOLV_HASH_ARCH_X86)
+                u32 regs[4] = { };
+                const auto cpuid = [&regs](u32 leaf, u32 subLeaf) {
+                    #if defined(_MSC_VER) && !defined(__clang__)
+                        __cpuidex(reinterpret_cast<int*>(regs), int(leaf), int(subLeaf));
+                    #else
+                        if (__get_cpuid_count(leaf, subLeaf, &regs[0], &regs[1], &regs[2], &regs[3]) == 0)
+                            regs[0] = regs[1] = regs[2] = regs[3] = 0;
+                    #endif
+                };
+
+                cpuid(0, 0);
+                const auto maxLeaf = regs[0];
+
+                cpuid(1, 0);
+                result.ssse3 = (regs[2] & (1U << 9)) != 0;
+                result.sse41 = (regs[2] & (1U << 19)) != 0;
+
+                // AVX registers are only usable if the OS saves and restores them on context switches
+                bool avxUsable = false;
+                if ((regs[2] & (1U << 27)) != 0 && (regs[2] & (1U << 28)) != 0) {
+                    #if defined(_MSC_VER) && !defined(__clang__)
+                        const auto xcr0 = _xgetbv(0);
+                    #else
+                        u32 xcr0Low, xcr0High;
+                        __asm__ volatile ("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+                        const auto xcr0 = (u64(xcr0High) << 32) | xcr0Low;
+                    #endif
+
+                    avxUsable = (xcr0 & 0b110) == 0b110;
+                }
+
+                if (maxLeaf >= 7) {
+                    cpuid(7, 0);
+                    result.avx2 = avxUsable && (regs[1] & (1U << 5)) != 0;
+                    result.sha  = (regs[1] & (1U << 29)) != 0;
+                }
+            #endif
+
+            return result;
+        }();
+
+        return features;
+    }
+
+}
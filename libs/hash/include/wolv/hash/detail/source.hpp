@@ -0,0 +1,38 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+namespace wolv::hash::detail {
+
+    /**
+     * @brief Reads data from a generic data source
+     * @param source Object providing either readBufferAtomic(address, buffer, size), like wolv::io::File,
+     *               or read(address, buffer, size), like wolv::io::BufferedReader
+     * @param address Address to read from
+     * @param buffer Buffer to read into
+     * @param size Number of bytes to read
+     * @return Number of bytes that were read
+     */
+    size_t readSource(auto &source, u64 address, u8 *buffer, size_t size) {
+        if constexpr (requires { source.readBufferAtomic(address, buffer, size); }) {
+            const auto result = source.readBufferAtomic(address, buffer, size);
+            return result > 0 ? size_t(result) : 0;
+        } else {
+            source.read(address, buffer, size);
+            return size;
+        }
+    }
+
+    /**
+     * @brief Returns a pointer to the memory mapping of a source if it provides one, like a mapped wolv::io::File
+     * @param source Data source
+     * @return Pointer to the start of the mapping or nullptr if the source isn't mapped
+     */
+    const u8* getSourceMapping(const auto &source) {
+        if constexpr (requires { source.getMapping(); })
+            return source.getMapping();
+        else
+            return nullptr;
+    }
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <wolv/types.hpp>
+#include <wolv/hash/detail/block_digest.hpp>
+
+#include <array>
+#include <bit>
+#include <span>
+
+namespace wolv::hash {
+
+    namespace detail {
+
+        inline constexpr std::array<u32, 64> Md5RoundConstants = {
+            0xD76AA478, 0xE8C7B756, 0x242070DB, 0xC1BDCEEE, 0xF57C0FAF, 0x4787C62A, 0xA8304613, 0xFD469501,
+            0x698098D8, 0x8B44F7AF, 0xFFFF5BB1, 0x895CD7BE, 0x6B901122, 0xFD987193, 0xA679438E, 0x49B40821,
+            0xF61E2562, 0xC040B340, 0x265E5A51, 0xE9B6C7AA, 0xD62F105D, 0x02441453, 0xD8A1E681, 0xE7D3FBC8,
+            0x21E1CDE6, 0xC33707D6, 0xF4D50D87, 0x455A14ED, 0xA9E3E905, 0xFCEFA3F8, 0x676F02D9, 0x8D2A4C8A,
+            0xFFFA3942, 0x8771F681, 0x6D9D6122, 0xFDE5380C, 0xA4BEEA44, 0x4BDECFA9, 0xF6BB4B60, 0xBEBFBC70,
+            0x289B7EC6, 0xEAA127FA, 0xD4EF3085, 0x04881D05, 0xD9D4D039, 0xE6DB99E5, 0x1FA27CF8, 0xC4AC5665,
+            0xF4292244, 0x432AFF97, 0xAB9423A7, 0xFC93A039, 0x655B59C3, 0x8F0CCC92, 0xFFEFF47D, 0x85845DD1,
+            0x6FA87E4F, 0xFE2CE6E0, 0xA3014314, 0x4E0811A1, 0xF7537E82, 0xBD3AF235, 0x2AD7D2BB, 0xEB86D391
+        };
+
+        inline constexpr std::array<u8, 64> Md5Shifts = {
+            7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+            5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+            4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+            6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+        };
+
+        using Md5State = std::array<u32, 4>;
+
+        inline void md5Compress(Md5State &state, const u8 *data, size_t blockCount) {
+            for (size_t block = 0; block < blockCount; block++, data += 64) {
+                std::array<u32, 16> m;
+                for (size_t i = 0; i < 16; i++)
+                    m[i] = loadLE32(data + i * 4);
+
+                auto [a, b, c, d] = state;
+                for (size_t i = 0; i < 64; i++) {
+                    u32 f;
+                    size_t g;
+                    if (i < 16) {
+                        f = (b & c) | (~b & d);
+                        g = i;
+                    } else if (i < 32) {
+                        f = (d & b) | (~d & c);
+                        g = (5 * i + 1) % 16;
+                    } else if (i < 48) {
+                        f = b ^ c ^ d;
+                        g = (3 * i + 5) % 16;
+                    } else {
+                        f = c ^ (b | ~d);
+                        g = (7 * i) % 16;
+                    }
+
+                    f = f + a + Md5RoundConstants[i] + m[g];
+                    a = d;
+                    d = c;
+                    c = b;
+                    b = b + std::rotl(f, Md5Shifts[i]);
+                }
+
+                state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            }
+        }
+
+    }
+
+    /**
+     * @brief Streaming MD5 digest
+     */
+    class Md5 : public detail::BlockDigest<Md5, detail::Md5State, std::endian::little> {
+    public:
+        using Digest = std::array<u8, 16>;
+
+        constexpr static detail::Md5State InitialState = {
+            0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476
+        };
+
+        Md5() {
+            this->reset();
+        }
+
+        [[nodiscard]]
+        Digest getResult() const {
+            const auto state = this->finalize();
+
+            Digest result;
+            for (size_t i = 0; i < state.size(); i++)
+                detail::storeLE32(result.data() + i * 4, state[i]);
+
+            return result;
+        }
+
+        /**
+         * @brief Runs the compression function over a number of consecutive 64 byte blocks
+         * @param state Chaining state to update
+         * @param data Pointer to the first block
+         * @param blockCount Number of blocks to process
+         */
+        static void compress(detail::Md5State &state, const u8 *data, size_t blockCount) {
+            detail::md5Compress(state, data, blockCount);
+        }
+    };
+
+}
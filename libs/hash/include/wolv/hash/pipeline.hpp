@@ -0,0 +1,155 @@
+#pragma once
+
+#include <wolv/types.hpp>
+#include <wolv/hash/detail/source.hpp>
+#include <wolv/utils/thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <latch>
+#include <span>
+#include <vector>
+
+namespace wolv::hash {
+
+    /**
+     * @brief Size of the blocks that are read from a source and handed to all hashers before moving on to the next one
+     */
+    constexpr static size_t PipelineChunkSize = 0x100000;
+
+    /**
+     * @brief Reads a range of data once and feeds it into any number of hashers
+     * @details If the source is memory mapped (e.g. a mapped wolv::io::File), the data is hashed in place without any copies.
+     *          Otherwise it gets read chunk by chunk, with every chunk being processed by all hashers while it's still in cache
+     * @param source Object providing readBufferAtomic(address, buffer, size) like wolv::io::File or read(address, buffer, size)
+     *               like wolv::io::BufferedReader
+     * @param address Address to start hashing at
+     * @param size Number of bytes to hash
+     * @param hashers Hashers to feed the data into. Each one needs a process(std::span<const u8>) function, like Crc or Sha256
+     * @return True if the whole range was hashed, false if reading from the source failed
+     */
+    template<typename ... Hashers> requires (sizeof...(Hashers) > 0)
+    bool hashRange(auto &source, u64 address, u64 size, Hashers &... hashers) {
+        const auto processChunk = [&](std::span<const u8> chunk) {
+            (hashers.process(chunk), ...);
+        };
+
+        if (const auto mapping = detail::getSourceMapping(source); mapping != nullptr) {
+            for (u64 offset = 0; offset < size; offset += PipelineChunkSize)
+                processChunk({ mapping + address + offset, size_t(std::min<u64>(PipelineChunkSize, size - offset)) });
+
+            return true;
+        }
+
+        std::vector<u8> buffer(size_t(std::min<u64>(PipelineChunkSize, size)));
+        while (size > 0) {
+            const auto bytesRead = detail::readSource(source, address, buffer.data(), size_t(std::min<u64>(buffer.size(), size)));
+            if (bytesRead == 0)
+                return false;
+
+            processChunk(std::span(buffer).first(bytesRead));
+            address += bytesRead;
+            size -= bytesRead;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Reads a range of data once and feeds it into any number of hashers, running every hasher on its own worker thread
+     * @details If the source is memory mapped, every hasher processes the whole range independently.
+     *          Otherwise the data is double buffered: the calling thread reads the next chunk while the workers hash the current one.
+     *          If the pool can't run the hashers while the calling thread waits for them (it has no workers, has been stopped or
+     *          this is called from one of its workers), everything is hashed on the calling thread instead
+     * @param pool Thread pool to run the hashers on
+     * @param source Object providing readBufferAtomic(address, buffer, size) like wolv::io::File or read(address, buffer, size)
+     *               like wolv::io::BufferedReader
+     * @param address Address to start hashing at
+     * @param size Number of bytes to hash
+     * @param hashers Hashers to feed the data into. Each one needs a process(std::span<const u8> bytes) function, like Crc or Sha256
+     * @return True if the whole range was hashed, false if reading from the source failed
+     */
+    template<typename ... Hashers> requires (sizeof...(Hashers) > 0)
+    bool hashRange(util::ThreadPool &pool, auto &source, u64 address, u64 size, Hashers &... hashers) {
+        if (!pool.canWaitForTasks())
+            return hashRange(source, address, size, hashers...);
+
+        if (const auto mapping = detail::getSourceMapping(source); mapping != nullptr) {
+            std::latch done(sizeof...(Hashers));
+
+            const auto enqueueHasher = [&](auto &hasher) {
+                pool.enqueue([&hasher, &done, data = mapping + address, size](const auto &) {
+                    for (u64 offset = 0; offset < size; offset += PipelineChunkSize)
+                        hasher.process({ data + offset, size_t(std::min<u64>(PipelineChunkSize, size - offset)) });
+
+                    done.count_down();
+                });
+            };
+
+            (enqueueHasher(hashers), ...);
+            done.wait();
+
+            return true;
+        }
+
+        const auto bufferSize = size_t(std::min<u64>(PipelineChunkSize, size));
+        std::array<std::vector<u8>, 2> buffers = { std::vector<u8>(bufferSize), std::vector<u8>(bufferSize) };
+
+        const auto readChunk = [&](std::vector<u8> &buffer) -> std::span<const u8> {
+            const auto bytesRead = detail::readSource(source, address, buffer.data(), size_t(std::min<u64>(buffer.size(), size)));
+            address += bytesRead;
+            size -= bytesRead;
+
+            return std::span(buffer).first(bytesRead);
+        };
+
+        size_t currentBuffer = 0;
+        auto chunk = size > 0 ? readChunk(buffers[currentBuffer]) : std::span<const u8>();
+
+        while (!chunk.empty()) {
+            std::latch done(sizeof...(Hashers));
+
+            const auto enqueueHasher = [&](auto &hasher) {
+                pool.enqueue([&hasher, &done, chunk](const auto &) {
+                    hasher.process(chunk);
+                    done.count_down();
+                });
+            };
+
+            (enqueueHasher(hashers), ...);
+
+            // Read the next chunk while the workers are busy with the current one
+            currentBuffer ^= 1;
+            const auto nextChunk = size > 0 ? readChunk(buffers[currentBuffer]) : std::span<const u8>();
+
+            done.wait();
+            chunk = nextChunk;
+        }
+
+        return size == 0;
+    }
+
+    /**
+     * @brief Hashes the entire content of a file once, feeding it into any number of hashers
+     * @param file File to hash, e.g. a wolv::io::File
+     * @param hashers Hashers to feed the data into
+     * @return True if the whole file was hashed
+     */
+    template<typename ... Hashers> requires (sizeof...(Hashers) > 0)
+    bool hashFile(auto &file, Hashers &... hashers) {
+        return hashRange(file, 0, file.getSize(), hashers...);
+    }
+
+    /**
+     * @brief Hashes the entire content of a file once, running every hasher on its own worker thread
+     * @param pool Thread pool to run the hashers on
+     * @param file File to hash, e.g. a wolv::io::File
+     * @param hashers Hashers to feed the data into
+     * @return True if the whole file was hashed
+     */
+    template<typename ... Hashers> requires (sizeof...(Hashers) > 0)
+    bool hashFile(util::ThreadPool &pool, auto &file, Hashers &... hashers) {
+        return hashRange(pool, file, 0, file.getSize(), hashers...);
+    }
+
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <array>
+#include <bit>
+#include <span>
+
+namespace wolv::hash {
+
+    namespace detail {
+
+        /**
+         * @brief Generates a table of 256 pseudo-random values at compile time using SplitMix64
+         * @param seed Seed of the generator
+         * @return Table mapping every byte value to a random 64 bit value
+         */
+        constexpr std::array<u64, 256> generateByteTable(u64 seed) {
+            std::array<u64, 256> table = { };
+
+            for (auto &value : table) {
+                seed += 0x9E3779B97F4A7C15ULL;
+
+                u64 z = seed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                value = z ^ (z >> 31);
+            }
+
+            return table;
+        }
+
+        inline constexpr auto GearTable    = generateByteTable(0x5745'5257'4F4C'4621ULL);
+        inline constexpr auto BuzhashTable = generateByteTable(0x4255'5A48'4153'4821ULL);
+
+    }
+
+    /**
+     * @brief Rabin-Karp polynomial rolling hash over a fixed size window
+     * @details The hash of a window w[0..n-1] is sum(w[i] * Base^(n - 1 - i)) mod 2^64
+     */
+    class RabinKarp {
+    public:
+        constexpr static u64 Base = 0x5851F42D4C957F2DULL;
+
+        /**
+         * @brief Creates a new rolling hash
+         * @param windowSize Number of bytes the hash spans
+         */
+        constexpr explicit RabinKarp(size_t windowSize) : m_windowSize(windowSize) {
+            // Weight of the byte leaving the window, Base^(windowSize - 1)
+            for (size_t i = 1; i < windowSize; i++)
+                this->m_outgoingFactor *= Base;
+        }
+
+        constexpr void reset() {
+            this->m_value = 0;
+        }
+
+        /**
+         * @brief Appends bytes to the hash without removing any. Used to fill the initial window
+         * @param bytes Bytes to append
+         */
+        constexpr void process(std::span<const u8> bytes) {
+            for (u8 byte : bytes)
+                this->append(byte);
+        }
+
+        constexpr void process(auto begin, auto end) {
+            this->process({ begin, end });
+        }
+
+        constexpr void append(u8 incoming) {
+            this->m_value = this->m_value * Base + incoming;
+        }
+
+        /**
+         * @brief Slides the window one byte forward
+         * @param outgoing Oldest byte of the window which is being removed
+         * @param incoming New byte being added to the window
+         */
+        constexpr void roll(u8 outgoing, u8 incoming) {
+            this->m_value = (this->m_value - outgoing * this->m_outgoingFactor) * Base + incoming;
+        }
+
+        [[nodiscard]]
+        constexpr u64 getResult() const {
+            return this->m_value;
+        }
+
+        [[nodiscard]]
+        constexpr size_t getWindowSize() const {
+            return this->m_windowSize;
+        }
+
+    private:
+        size_t m_windowSize;
+        u64 m_outgoingFactor = 1;
+        u64 m_value = 0;
+    };
+
+    /**
+     * @brief Buzhash (cyclic polynomial) rolling hash over a fixed size window
+     * @details Uses only rotations and XORs, which makes removing the outgoing byte cheaper than with Rabin-Karp
+     */
+    class Buzhash {
+    public:
+        /**
+         * @brief Creates a new rolling hash
+         * @param windowSize Number of bytes the hash spans
+         */
+        constexpr explicit Buzhash(size_t windowSize) : m_windowSize(windowSize) { }
+
+        constexpr void reset() {
+            this->m_value = 0;
+        }
+
+        /**
+         * @brief Appends bytes to the hash without removing any. Used to fill the initial window
+         * @param bytes Bytes to append
+         */
+        constexpr void process(std::span<const u8> bytes) {
+            for (u8 byte : bytes)
+                this->append(byte);
+        }
+
+        constexpr void process(auto begin, auto end) {
+            this->process({ begin, end });
+        }
+
+        constexpr void append(u8 incoming) {
+            this->m_value = std::rotl(this->m_value, 1) ^ detail::BuzhashTable[incoming];
+        }
+
+        /**
+         * @brief Slides the window one byte forward
+         * @param outgoing Oldest byte of the window which is being removed
+         * @param incoming New byte being added to the window
+         */
+        constexpr void roll(u8 outgoing, u8 incoming) {
+            this->m_value = std::rotl(this->m_value, 1) ^ std::rotl(detail::BuzhashTable[outgoing], int(this->m_windowSize % 64)) ^ detail::BuzhashTable[incoming];
+        }
+
+        [[nodiscard]]
+        constexpr u64 getResult() const {
+            return this->m_value;
+        }
+
+        [[nodiscard]]
+        constexpr size_t getWindowSize() const {
+            return this->m_windowSize;
+        }
+
+    private:
+        size_t m_windowSize;
+        u64 m_value = 0;
+    };
+
+    /**
+     * @brief Gear rolling hash as used by FastCDC
+     * @details Every appended byte shifts the previous state left by one, so the result only depends on the last 64 bytes.
+     *          There is no explicit window and therefore no need to remove outgoing bytes
+     */
+    class GearHash {
+    public:
+        constexpr GearHash() = default;
+
+        constexpr void reset() {
+            this->m_value = 0;
+        }
+
+        constexpr void process(std::span<const u8> bytes) {
+            for (u8 byte : bytes)
+                this->append(byte);
+        }
+
+        constexpr void process(auto begin, auto end) {
+            this->process({ begin, end });
+        }
+
+        constexpr void append(u8 incoming) {
+            this->m_value = (this->m_value << 1) + detail::GearTable[incoming];
+        }
+
+        [[nodiscard]]
+        constexpr u64 getResult() const {
+            return this->m_value;
+        }
+
+    private:
+        u64 m_value = 0;
+    };
+
+}
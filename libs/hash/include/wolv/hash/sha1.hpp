@@ -0,0 +1,167 @@
+#pragma once
+
+#include <wolv/types.hpp>
+#include <wolv/hash/detail/block_digest.hpp>
+#include <wolv/hash/detail/cpu.hpp>
+
+#include <array>
+#include <bit>
+#include <span>
+#include <utility>
+
+namespace wolv::hash {
+
+    namespace detail {
+
+        using Sha1State = std::array<u32, 5>;
+
+        inline void sha1CompressPortable(Sha1State &state, const u8 *data, size_t blockCount) {
+            for (size_t block = 0; block < blockCount; block++, data += 64) {
+                std::array<u32, 80> w;
+                for (size_t i = 0; i < 16; i++)
+                    w[i] = loadBE32(data + i * 4);
+
+                for (size_t i = 16; i < 80; i++)
+                    w[i] = std::rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+                auto [a, b, c, d, e] = state;
+                for (size_t i = 0; i < 80; i++) {
+                    u32 f, k;
+                    if (i < 20) {
+                        f = (b & c) | (~b & d);
+                        k = 0x5A827999;
+                    } else if (i < 40) {
+                        f = b ^ c ^ d;
+                        k = 0x6ED9EBA1;
+                    } else if (i < 60) {
+                        f = (b & c) | (b & d) | (c & d);
+                        k = 0x8F1BBCDC;
+                    } else {
+                        f = b ^ c ^ d;
+                        k = 0xCA62C1D6;
+                    }
+
+                    const auto temp = std::rotl(a, 5) + f + e + k + w[i];
+                    e = d;
+                    d = c;
+                    c = std::rotl(b, 30);
+                    b = a;
+                    a = temp;
+                }
+
+                state[0] += a; state[1] += b; state[2] += c; state[3] += d; state[4] += e;
+            }
+        }
+
+        #if defined(WOLV_HASH_ARCH_X86)
+
+            // Four rounds of SHA-1 using the SHA extensions. messages holds the last four message schedule vectors and
+            // e alternates between the E value consumed by this group and the one saved for the next group
+            template<size_t Group>
+            WOLV_HASH_TARGET("sha,sse4.1") inline void sha1ShaNiRounds(__m128i &abcd, __m128i (&e)[2], __m128i (&messages)[4]) {
+                const auto &current = messages[Group % 4];
+                auto &eCurrent = e[Group % 2];
+
+                if constexpr (Group == 0)
+                    eCurrent = _mm_add_epi32(eCurrent, current);
+                else
+                    eCurrent = _mm_sha1nexte_epu32(eCurrent, current);
+
+                e[(Group + 1) % 2] = abcd;
+
+                if constexpr (Group >= 3 && Group <= 18)
+                    messages[(Group + 1) % 4] = _mm_sha1msg2_epu32(messages[(Group + 1) % 4], current);
+
+                abcd = _mm_sha1rnds4_epu32(abcd, eCurrent, Group / 5);
+
+                if constexpr (Group >= 1 && Group <= 16)
+                    messages[(Group + 3) % 4] = _mm_sha1msg1_epu32(messages[(Group + 3) % 4], current);
+                if constexpr (Group >= 2 && Group <= 17)
+                    messages[(Group + 2) % 4] = _mm_xor_si128(messages[(Group + 2) % 4], current);
+            }
+
+            template<size_t ... Groups>
+            WOLV_HASH_TARGET("sha,sse4.1") inline void sha1ShaNiBlock(__m128i &abcd, __m128i (&e)[2], __m128i (&messages)[4], std::index_sequence<Groups...>) {
+                (sha1ShaNiRounds<Groups>(abcd, e, messages), ...);
+            }
+
+            WOLV_HASH_TARGET("sha,sse4.1") inline void sha1CompressShaNi(Sha1State &state, const u8 *data, size_t blockCount) {
+                const auto byteSwapMask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090A0B0C0D0E0FULL);
+
+                auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0x1B);
+                auto e0 = _mm_set_epi32(int(state[4]), 0, 0, 0);
+
+                for (size_t block = 0; block < blockCount; block++, data += 64) {
+                    const auto abcdSaved = abcd;
+                    const auto e0Saved = e0;
+
+                    __m128i messages[4];
+                    for (size_t i = 0; i < 4; i++)
+                        messages[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)), byteSwapMask);
+
+                    __m128i e[2] = { e0, _mm_setzero_si128() };
+                    sha1ShaNiBlock(abcd, e, messages, std::make_index_sequence<20>{});
+
+                    e0 = _mm_sha1nexte_epu32(e[0], e0Saved);
+                    abcd = _mm_add_epi32(abcd, abcdSaved);
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_shuffle_epi32(abcd, 0x1B));
+                state[4] = u32(_mm_extract_epi32(e0, 3));
+            }
+
+        #endif
+
+    }
+
+    /**
+     * @brief Streaming SHA-1 digest
+     * @note Uses the Intel SHA extensions if the CPU supports them and falls back to a portable implementation otherwise
+     */
+    class Sha1 : public detail::BlockDigest<Sha1, detail::Sha1State, std::endian::big> {
+    public:
+        using Digest = std::array<u8, 20>;
+
+        constexpr static detail::Sha1State InitialState = {
+            0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+        };
+
+        Sha1() {
+            this->reset();
+        }
+
+        [[nodiscard]]
+        Digest getResult() const {
+            const auto state = this->finalize();
+
+            Digest result;
+            for (size_t i = 0; i < state.size(); i++)
+                detail::storeBE32(result.data() + i * 4, state[i]);
+
+            return result;
+        }
+
+        /**
+         * @brief Runs the compression function over a number of consecutive 64 byte blocks
+         * @param state Chaining state to update
+         * @param data Pointer to the first block
+         * @param blockCount Number of blocks to process
+         */
+        static void compress(detail::Sha1State &state, const u8 *data, size_t blockCount) {
+            using CompressFunction = void(*)(detail::Sha1State &, const u8 *, size_t);
+
+            static const CompressFunction function = []() -> CompressFunction {
+                #if defined(WOLV_HASH_ARCH_X86)
+                    const auto &features = detail::getCpuFeatures();
+                    if (features.sha && features.ssse3 && features.sse41)
+                        return detail::sha1CompressShaNi;
+                #endif
+
+                return detail::sha1CompressPortable;
+            }();
+
+            function(state, data, blockCount);
+        }
+    };
+
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <wolv/types.hpp>
+#include <wolv/hash/detail/block_digest.hpp>
+#include <wolv/hash/detail/cpu.hpp>
+
+#include <array>
+#include <bit>
+#include <span>
+#include <utility>
+
+namespace wolv::hash {
+
+    namespace detail {
+
+        inline constexpr std::array<u32, 64> Sha256RoundConstants = {
+            0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+            0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+            0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+            0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+            0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+            0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+            0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+            0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+        };
+
+        using Sha256State = std::array<u32, 8>;
+
+        inline void sha256CompressPortable(Sha256State &state, const u8 *data, size_t blockCount) {
+            for (size_t block = 0; block < blockCount; block++, data += 64) {
+                std::array<u32, 64> w;
+                for (size_t i = 0; i < 16; i++)
+                    w[i] = loadBE32(data + i * 4);
+
+                for (size_t i = 16; i < 64; i++) {
+                    const auto s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                    const auto s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+                }
+
+                auto [a, b, c, d, e, f, g, h] = state;
+                for (size_t i = 0; i < 64; i++) {
+                    const auto s1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+                    const auto ch = (e & f) ^ (~e & g);
+                    const auto temp1 = h + s1 + ch + Sha256RoundConstants[i] + w[i];
+                    const auto s0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+                    const auto maj = (a & b) ^ (a & c) ^ (b & c);
+                    const auto temp2 = s0 + maj;
+
+                    h = g;
+                    g = f;
+                    f = e;
+                    e = d + temp1;
+                    d = c;
+                    c = b;
+                    b = a;
+                    a = temp1 + temp2;
+                }
+
+                state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+                state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+            }
+        }
+
+        #if defined(WOLV_HASH_ARCH_X86)
+
+            // Four rounds of SHA-256 using the SHA extensions. messages holds the last four message schedule vectors
+            template<size_t Group>
+            WOLV_HASH_TARGET("sha,sse4.1") inline void sha256ShaNiRounds(__m128i &abef, __m128i &cdgh, __m128i (&messages)[4]) {
+                auto &current = messages[Group % 4];
+
+                if constexpr (Group >= 4) {
+                    const auto &previous = messages[(Group + 3) % 4];
+                    const auto sum = _mm_add_epi32(_mm_sha256msg1_epu32(current, messages[(Group + 1) % 4]), _mm_alignr_epi8(previous, messages[(Group + 2) % 4], 4));
+                    current = _mm_sha256msg2_epu32(sum, previous);
+                }
+
+                const auto schedule = _mm_add_epi32(current, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Sha256RoundConstants[Group * 4])));
+                cdgh = _mm_sha256rnds2_epu32(cdgh, abef, schedule);
+                abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(schedule, 0x0E));
+            }
+
+            template<size_t ... Groups>
+            WOLV_HASH_TARGET("sha,sse4.1") inline void sha256ShaNiBlock(__m128i &abef, __m128i &cdgh, __m128i (&messages)[4], std::index_sequence<Groups...>) {
+                (sha256ShaNiRounds<Groups>(abef, cdgh, messages), ...);
+            }
+
+            WOLV_HASH_TARGET("sha,sse4.1") inline void sha256CompressShaNi(Sha256State &state, const u8 *data, size_t blockCount) {
+                const auto byteSwapMask = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+
+                // Rearrange the state from ABCD EFGH into the ABEF CDGH layout the instructions operate on
+                auto cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+                auto efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+                auto abef = _mm_alignr_epi8(cdab, efgh, 8);
+                auto cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+                for (size_t block = 0; block < blockCount; block++, data += 64) {
+                    const auto abefSaved = abef;
+                    const auto cdghSaved = cdgh;
+
+                    __m128i messages[4];
+                    for (size_t i = 0; i < 4; i++)
+                        messages[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)), byteSwapMask);
+
+                    sha256ShaNiBlock(abef, cdgh, messages, std::make_index_sequence<16>{});
+
+                    abef = _mm_add_epi32(abef, abefSaved);
+                    cdgh = _mm_add_epi32(cdgh, cdghSaved);
+                }
+
+                const auto feba = _mm_shuffle_epi32(abef, 0x1B);
+                const auto dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+            }
+
+        #endif
+
+    }
+
+    /**
+     * @brief Streaming SHA-256 digest
+     * @note Uses the Intel SHA extensions if the CPU supports them and falls back to a portable implementation otherwise
+     */
+    class Sha256 : public detail::BlockDigest<Sha256, detail::Sha256State, std::endian::big> {
+    public:
+        using Digest = std::array<u8, 32>;
+
+        constexpr static detail::Sha256State InitialState = {
+            0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+        };
+
+        Sha256() {
+            this->reset();
+        }
+
+        [[nodiscard]]
+        Digest getResult() const {
+            const auto state = this->finalize();
+
+            Digest result;
+            for (size_t i = 0; i < state.size(); i++)
+                detail::storeBE32(result.data() + i * 4, state[i]);
+
+            return result;
+        }
+
+        /**
+         * @brief Runs the compression function over a number of consecutive 64 byte blocks
+         * @param state Chaining state to update
+         * @param data Pointer to the first block
+         * @param blockCount Number of blocks to process
+         */
+        static void compress(detail::Sha256State &state, const u8 *data, size_t blockCount) {
+            using CompressFunction = void(*)(detail::Sha256State &, const u8 *, size_t);
+
+            static const CompressFunction function = []() -> CompressFunction {
+                #if defined(WOLV_HASH_ARCH_X86)
+                    const auto &features = detail::getCpuFeatures();
+                    if (features.sha && features.ssse3 && features.sse41)
+                        return detail::sha256CompressShaNi;
+                #endif
+
+                return detail::sha256CompressPortable;
+            }();
+
+            function(state, data, blockCount);
+        }
+    };
+
+}
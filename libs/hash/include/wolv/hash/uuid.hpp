@@ -2,30 +2,325 @@
 
 #include <wolv/types.hpp>
 
+#include <array>
+#include <bit>
+#include <chrono>
+#include <compare>
+#include <cstring>
+#include <optional>
 #include <random>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define WOLV_HASH_UUID_SSE2
+    #include <emmintrin.h>
+#endif
 
 namespace wolv::hash {
 
-    inline std::string generateUUID() {
-        std::random_device randomDevice;
-        std::mt19937 generator(randomDevice());
-
-        std::uniform_int_distribution<u16> distribution(0, 15);
-
-        std::string uuid = "xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx";
-        for (char &c : uuid) {
-            if (c == 'x') {
-                c = distribution(generator);
-                c = c < 10 ? char('0' + c) : char('a' + c - 10);
-            } else if (c == 'y') {
-                c = distribution(generator);
-                c = char(char(c & u8(0x03)) | char(0x08));
-                c = c < 10 ? char('0' + c) : char('a' + c - 10);
+    namespace detail {
+
+        /**
+         * @brief xoshiro256** pseudo random number generator
+         * @note Not suitable for cryptographic purposes
+         */
+        class Xoshiro256StarStar {
+        public:
+            using result_type = u64;
+
+            explicit Xoshiro256StarStar(u64 seed) {
+                // Expand the seed into the full state using SplitMix64 as recommended by the authors
+                for (auto &word : this->m_state) {
+                    seed += 0x9E3779B97F4A7C15ULL;
+
+                    u64 z = seed;
+                    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                    word = z ^ (z >> 31);
+                }
+            }
+
+            constexpr static u64 min() { return 0; }
+            constexpr static u64 max() { return ~u64(0); }
+
+            u64 operator()() {
+                auto &s = this->m_state;
+
+                const u64 result = std::rotl(s[1] * 5, 7) * 9;
+                const u64 t = s[1] << 17;
+
+                s[2] ^= s[0];
+                s[3] ^= s[1];
+                s[1] ^= s[2];
+                s[0] ^= s[3];
+                s[2] ^= t;
+                s[3] = std::rotl(s[3], 45);
+
+                return result;
             }
+
+        private:
+            std::array<u64, 4> m_state = { };
+        };
+
+        /**
+         * @brief Returns a generator local to the calling thread which gets seeded once on first use
+         */
+        inline Xoshiro256StarStar& getThreadRandomGenerator() {
+            thread_local Xoshiro256StarStar generator([] {
+                std::random_device randomDevice;
+
+                u64 seed = (u64(randomDevice()) << 32) | randomDevice();
+                seed ^= u64(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+                seed ^= u64(std::hash<std::thread::id>{}(std::this_thread::get_id())) * 0x9E3779B97F4A7C15ULL;
+
+                return seed;
+            }());
+
+            return generator;
         }
 
-        return uuid;
     }
 
-}
\ No newline at end of file
+    /**
+     * @brief 128 bit binary representation of a UUID as described in RFC 9562
+     */
+    struct Uuid {
+        enum class Version : u8 {
+            Random      = 4,
+            TimeOrdered = 7
+        };
+
+        constexpr static size_t StringLength = 36;
+
+        std::array<u8, 16> bytes = { };
+
+        /**
+         * @brief Generates a random version 4 UUID
+         */
+        [[nodiscard]] static Uuid generateV4() {
+            Uuid uuid;
+            generate(std::span(&uuid, 1), Version::Random);
+
+            return uuid;
+        }
+
+        /**
+         * @brief Generates a version 7 UUID which sorts by its creation time
+         * @note UUIDs created on the same thread within the same millisecond are still strictly increasing
+         */
+        [[nodiscard]] static Uuid generateV7() {
+            Uuid uuid;
+            generate(std::span(&uuid, 1), Version::TimeOrdered);
+
+            return uuid;
+        }
+
+        /**
+         * @brief Fills a range with newly generated UUIDs
+         * @param uuids Range to fill
+         * @param version Version of the UUIDs to generate
+         */
+        static void generate(std::span<Uuid> uuids, Version version = Version::Random) {
+            auto &generator = detail::getThreadRandomGenerator();
+
+            if (version == Version::Random) {
+                for (auto &uuid : uuids) {
+                    const u64 high = generator(), low = generator();
+                    std::memcpy(uuid.bytes.data() + 0, &high, sizeof(high));
+                    std::memcpy(uuid.bytes.data() + 8, &low, sizeof(low));
+
+                    uuid.setVersionAndVariant(version);
+                }
+            } else {
+                // 48 bit millisecond timestamp followed by a 12 bit counter that keeps UUIDs monotonic within a millisecond
+                thread_local u64 lastTimestamp = 0;
+                thread_local u16 counter = 0;
+
+                const auto now = u64(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+                for (auto &uuid : uuids) {
+                    if (now > lastTimestamp) {
+                        lastTimestamp = now;
+                        // Start at a random value in the lower half to leave room for increments
+                        counter = u16(generator() & 0x07FF);
+                    } else if (++counter > 0x0FFF) {
+                        lastTimestamp += 1;
+                        counter = u16(generator() & 0x07FF);
+                    }
+
+                    for (size_t i = 0; i < 6; i++)
+                        uuid.bytes[i] = u8(lastTimestamp >> (40 - i * 8));
+                    uuid.bytes[6] = u8(counter >> 8);
+                    uuid.bytes[7] = u8(counter);
+
+                    const u64 random = generator();
+                    std::memcpy(uuid.bytes.data() + 8, &random, sizeof(random));
+
+                    uuid.setVersionAndVariant(version);
+                }
+            }
+        }
+
+        /**
+         * @brief Parses a UUID in its canonical "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" form or as 32 hex digits without dashes
+         * @param string String to parse. Upper and lower case hex digits are accepted
+         * @return Parsed UUID or std::nullopt if the string isn't a valid UUID
+         */
+        [[nodiscard]] static std::optional<Uuid> parse(std::string_view string) {
+            std::array<char, 32> digits;
+
+            if (string.size() == StringLength) {
+                if (string[8] != '-' || string[13] != '-' || string[18] != '-' || string[23] != '-')
+                    return std::nullopt;
+
+                std::memcpy(digits.data() +  0, string.data() +  0, 8);
+                std::memcpy(digits.data() +  8, string.data() +  9, 4);
+                std::memcpy(digits.data() + 12, string.data() + 14, 4);
+                std::memcpy(digits.data() + 16, string.data() + 19, 4);
+                std::memcpy(digits.data() + 20, string.data() + 24, 12);
+            } else if (string.size() == digits.size()) {
+                std::memcpy(digits.data(), string.data(), digits.size());
+            } else {
+                return std::nullopt;
+            }
+
+            Uuid uuid;
+            if (!decodeHex(digits, uuid.bytes))
+                return std::nullopt;
+
+            return uuid;
+        }
+
+        /**
+         * @brief Writes the canonical lower case representation of the UUID into a buffer
+         * @param buffer Buffer to write the 36 characters into. No null terminator is written
+         */
+        void format(std::span<char, StringLength> buffer) const {
+            std::array<char, 32> digits;
+            encodeHex(this->bytes, digits);
+
+            std::memcpy(buffer.data() +  0, digits.data() +  0, 8);
+            buffer[8] = '-';
+            std::memcpy(buffer.data() +  9, digits.data() +  8, 4);
+            buffer[13] = '-';
+            std::memcpy(buffer.data() + 14, digits.data() + 12, 4);
+            buffer[18] = '-';
+            std::memcpy(buffer.data() + 19, digits.data() + 16, 4);
+            buffer[23] = '-';
+            std::memcpy(buffer.data() + 24, digits.data() + 20, 12);
+        }
+
+        [[nodiscard]] std::string toString() const {
+            std::string result(StringLength, '\x00');
+            this->format(std::span<char, StringLength>(result.data(), StringLength));
+
+            return result;
+        }
+
+        [[nodiscard]] constexpr u8 getVersion() const {
+            return this->bytes[6] >> 4;
+        }
+
+        [[nodiscard]] constexpr bool isNil() const {
+            return *this == Uuid{};
+        }
+
+        constexpr auto operator<=>(const Uuid &other) const = default;
+
+    private:
+        constexpr void setVersionAndVariant(Version version) {
+            this->bytes[6] = u8((this->bytes[6] & 0x0F) | (u8(version) << 4));
+            this->bytes[8] = u8((this->bytes[8] & 0x3F) | 0x80);
+        }
+
+        static void encodeHex(const std::array<u8, 16> &input, std::array<char, 32> &output) {
+            #if defined(WOLV_HASH_UUID_SSE2)
+                const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data()));
+                const auto lowNibbleMask = _mm_set1_epi8(0x0F);
+
+                // Split every byte into its two nibbles and interleave them so the high nibble comes first
+                const auto high = _mm_and_si128(_mm_srli_epi16(value, 4), lowNibbleMask);
+                const auto low  = _mm_and_si128(value, lowNibbleMask);
+
+                const auto toAscii = [](__m128i nibbles) {
+                    const auto isLetter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+                    const auto offset = _mm_add_epi8(_mm_set1_epi8('0'), _mm_and_si128(isLetter, _mm_set1_epi8('a' - '0' - 10)));
+
+                    return _mm_add_epi8(nibbles, offset);
+                };
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output.data() +  0), toAscii(_mm_unpacklo_epi8(high, low)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output.data() + 16), toAscii(_mm_unpackhi_epi8(high, low)));
+            #else
+                constexpr static auto Digits = "0123456789abcdef";
+                for (size_t i = 0; i < input.size(); i++) {
+                    output[i * 2 + 0] = Digits[input[i] >> 4];
+                    output[i * 2 + 1] = Digits[input[i] & 0x0F];
+                }
+            #endif
+        }
+
+        static bool decodeHex(const std::array<char, 32> &input, std::array<u8, 16> &output) {
+            #if defined(WOLV_HASH_UUID_SSE2)
+                const auto decode = [](__m128i chars, __m128i &valid) {
+                    // Characters are compared as signed bytes, which is fine as all valid ones are below 0x80
+                    const auto inRange = [](__m128i value, char min, char max) {
+                        return _mm_and_si128(_mm_cmpgt_epi8(value, _mm_set1_epi8(char(min - 1))), _mm_cmplt_epi8(value, _mm_set1_epi8(char(max + 1))));
+                    };
+
+                    const auto lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+                    const auto isDigit  = inRange(chars, '0', '9');
+                    const auto isLetter = inRange(lower, 'a', 'f');
+                    valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isLetter));
+
+                    const auto digitValues  = _mm_and_si128(isDigit,  _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+                    const auto letterValues = _mm_and_si128(isLetter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+                    const auto nibbles = _mm_or_si128(digitValues, letterValues);
+
+                    // Combine each pair of nibbles into a byte, the first character being the high nibble
+                    const auto pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(nibbles, 8));
+
+                    return pairs;
+                };
+
+                auto valid = _mm_set1_epi8(char(0xFF));
+                const auto first  = decode(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() +  0)), valid);
+                const auto second = decode(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + 16)), valid);
+
+                if (_mm_movemask_epi8(valid) != 0xFFFF)
+                    return false;
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output.data()), _mm_packus_epi16(first, second));
+
+                return true;
+            #else
+                const auto toNibble = [](char c) -> int {
+                    if (c >= '0' && c <= '9') return c - '0';
+                    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+                    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+                    return -1;
+                };
+
+                for (size_t i = 0; i < output.size(); i++) {
+                    const auto high = toNibble(input[i * 2 + 0]);
+                    const auto low  = toNibble(input[i * 2 + 1]);
+                    if (high < 0 || low < 0)
+                        return false;
+
+                    output[i] = u8((high << 4) | low);
+                }
+
+                return true;
+            #endif
+        }
+    };
+
+    inline std::string generateUUID() {
+        return Uuid::generateV4().toString();
+    }
+
+}
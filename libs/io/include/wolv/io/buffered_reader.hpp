@@ -2,6 +2,7 @@
 
 #include <cstring>
 
+#include <memory_resource>
 #include <vector>
 
 namespace wolv::io {
@@ -12,10 +13,10 @@ namespace wolv::io {
     template<typename T, ReaderFunction<T> Reader>
     class BufferedReader {
     public:
-        explicit BufferedReader(T *userData, size_t dataSize, size_t bufferSize = 0x100000)
+        explicit BufferedReader(T *userData, size_t dataSize, size_t bufferSize = 0x100000, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
                 : m_userData(userData), m_bufferAddress(0x00), m_maxBufferSize(bufferSize),
                   m_startAddress(0x00), m_endAddress(std::max<size_t>(dataSize, 1) - 1LLU),
-                  m_buffer(bufferSize) {
+                  m_buffer(bufferSize, resource) {
 
         }
 
@@ -324,7 +325,7 @@ namespace wolv::io {
         size_t m_maxBufferSize;
         bool m_bufferValid = false;
         u64 m_startAddress = 0x00, m_endAddress;
-        std::vector<u8> m_buffer;
+        std::pmr::vector<u8> m_buffer;
     };
 
 }
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <wolv/types.hpp>
+#include <wolv/io/buffered_reader.hpp>
+
+#include <span>
+#include <vector>
+
+namespace wolv::io {
+
+    class File;
+
+    /**
+     * @brief Editable view of a large, immutable piece of data
+     * @details The base data, either a File or a memory mapping, is never modified. Inserted bytes are appended to a
+     *          separate add buffer instead and the content is described as a sequence of pieces, each referring to a
+     *          range of either the base or the add buffer. Pieces are kept in a balanced tree that stores the length of
+     *          every subtree, so finding the piece containing an offset, inserting and erasing all take O(log n) in the
+     *          number of pieces, independent of the size of the base data
+     * @note The base data must outlive the piece table and must not change while it's in use
+     */
+    class PieceTable {
+    public:
+        /**
+         * @brief Creates a piece table on top of a file
+         * @details If the file is mapped, its mapping is used directly. Otherwise base data is read through
+         *          File::readBufferAtomic
+         * @param file File to use as base data
+         */
+        explicit PieceTable(File &file);
+
+        /**
+         * @brief Creates a piece table on top of a block of memory
+         * @param data Memory to use as base data
+         */
+        explicit PieceTable(std::span<const u8> data);
+
+        PieceTable() = default;
+
+        /**
+         * @brief Inserts bytes in front of the given offset
+         * @param offset Offset to insert at, at most size()
+         * @param data Bytes to insert
+         * @throws std::out_of_range if the offset is past the end of the content
+         */
+        void insert(u64 offset, std::span<const u8> data);
+
+        /**
+         * @brief Removes bytes from the content
+         * @param offset Offset of the first byte to remove
+         * @param size Number of bytes to remove. Removing past the end of the content stops at the end
+         */
+        void erase(u64 offset, u64 size);
+
+        /**
+         * @brief Overwrites bytes of the content
+         * @details Writing past the end of the content extends it
+         * @param offset Offset of the first byte to overwrite, at most size()
+         * @param data Bytes to write
+         */
+        void write(u64 offset, std::span<const u8> data);
+
+        /**
+         * @brief Reads bytes from the current content
+         * @param offset Offset of the first byte to read
+         * @param buffer Buffer to read into
+         * @param size Number of bytes to read
+         * @return Number of bytes read. Less than size if the end of the content was reached or reading from the base
+         *         file failed
+         */
+        size_t read(u64 offset, u8 *buffer, size_t size) const;
+
+        /**
+         * @brief Reads bytes from the current content
+         * @param offset Offset of the first byte to read
+         * @param size Number of bytes to read
+         * @return Bytes read. Shorter than size if the end of the content was reached or reading from the base file failed
+         */
+        [[nodiscard]] std::vector<u8> read(u64 offset, size_t size) const;
+
+        /**
+         * @brief Writes the whole current content sequentially to a file
+         * @note The target must not be the base file of this piece table
+         * @param file File to write to
+         * @return True if all bytes have been read and written
+         */
+        bool save(File &file) const;
+
+        /**
+         * @brief Discards all edits and goes back to the unmodified base data
+         */
+        void reset();
+
+        /**
+         * @brief Returns the size of the current content
+         */
+        [[nodiscard]] u64 size() const;
+
+        /**
+         * @brief Returns the number of pieces the content is currently made of
+         */
+        [[nodiscard]] size_t getPieceCount() const;
+
+        /**
+         * @brief Reader function to use the piece table as data source of a BufferedReader
+         * @details Bytes past the end of the content are filled with zeros
+         */
+        static void readFunction(PieceTable *pieceTable, void *buffer, u64 address, size_t size);
+
+    private:
+        enum class Source : u8 {
+            Base,
+            Add
+        };
+
+        struct Node {
+            Source source;
+            u64 start, length;
+
+            u32 left, right;
+            u32 priority;
+            u64 subtreeLength;
+        };
+
+        static constexpr u32 Null = ~u32(0);
+
+        u32 createNode(Source source, u64 start, u64 length);
+        void releaseSubtree(u32 node);
+        void update(u32 node);
+
+        u32 merge(u32 left, u32 right);
+        std::pair<u32, u32> split(u32 node, u64 offset);
+        bool extendLastPiece(u32 node, u64 end, u64 count);
+
+        size_t readBase(u64 address, u8 *buffer, size_t size) const;
+
+        File *m_file = nullptr;
+        std::span<const u8> m_baseData;
+        u64 m_baseSize = 0;
+
+        std::vector<u8> m_addBuffer;
+
+        std::vector<Node> m_nodes;
+        std::vector<u32> m_freeNodes;
+        u32 m_root = Null;
+        u32 m_seed = 0x9E3779B9;
+    };
+
+    using PieceTableReader = BufferedReader<PieceTable, PieceTable::readFunction>;
+
+}
@@ -0,0 +1,300 @@
+#include <wolv/io/piece_table.hpp>
+#include <wolv/io/file.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace wolv::io {
+
+    PieceTable::PieceTable(File &file) : m_file(&file), m_baseSize(file.getSize()) {
+        this->reset();
+    }
+
+    PieceTable::PieceTable(std::span<const u8> data) : m_baseData(data), m_baseSize(data.size()) {
+        this->reset();
+    }
+
+    void PieceTable::insert(u64 offset, std::span<const u8> data) {
+        if (offset > this->size())
+            throw std::out_of_range("PieceTable insert offset is out of range");
+        if (data.empty())
+            return;
+
+        const u64 addStart = this->m_addBuffer.size();
+        this->m_addBuffer.insert(this->m_addBuffer.end(), data.begin(), data.end());
+
+        auto [left, right] = this->split(this->m_root, offset);
+
+        // Consecutive inserts, like typing, keep appending to the same piece instead of creating a new one every time
+        if (!this->extendLastPiece(left, addStart, data.size()))
+            left = this->merge(left, this->createNode(Source::Add, addStart, data.size()));
+
+        this->m_root = this->merge(left, right);
+    }
+
+    void PieceTable::erase(u64 offset, u64 size) {
+        const auto contentSize = this->size();
+        if (offset >= contentSize || size == 0)
+            return;
+
+        size = std::min(size, contentSize - offset);
+
+        auto [left, rest] = this->split(this->m_root, offset);
+        auto [removed, right] = this->split(rest, size);
+
+        this->releaseSubtree(removed);
+        this->m_root = this->merge(left, right);
+    }
+
+    void PieceTable::write(u64 offset, std::span<const u8> data) {
+        if (offset > this->size())
+            throw std::out_of_range("PieceTable write offset is out of range");
+
+        this->erase(offset, data.size());
+        this->insert(offset, data);
+    }
+
+    size_t PieceTable::read(u64 offset, u8 *buffer, size_t size) const {
+        // Find the piece containing the offset, remembering every node where the search went left. Those are the
+        // nodes that follow the current piece once its right subtree has been visited
+        std::vector<u32> ancestors;
+        u32 node = this->m_root;
+        u64 position = offset;
+        while (node != Null) {
+            const auto &piece = this->m_nodes[node];
+            const u64 leftLength = piece.left == Null ? 0 : this->m_nodes[piece.left].subtreeLength;
+
+            if (position < leftLength) {
+                ancestors.push_back(node);
+                node = piece.left;
+            } else if (position < leftLength + piece.length) {
+                position -= leftLength;
+                break;
+            } else {
+                position -= leftLength + piece.length;
+                node = piece.right;
+            }
+        }
+
+        size_t bytesRead = 0;
+        while (node != Null && bytesRead < size) {
+            const auto &piece = this->m_nodes[node];
+            const auto count = size_t(std::min<u64>(piece.length - position, size - bytesRead));
+
+            if (piece.source == Source::Base) {
+                const auto baseBytesRead = this->readBase(piece.start + position, buffer + bytesRead, count);
+
+                bytesRead += baseBytesRead;
+                if (baseBytesRead != count)
+                    break;
+            } else {
+                std::memcpy(buffer + bytesRead, this->m_addBuffer.data() + piece.start + position, count);
+                bytesRead += count;
+            }
+
+            position = 0;
+
+            if (piece.right != Null) {
+                node = piece.right;
+                while (this->m_nodes[node].left != Null) {
+                    ancestors.push_back(node);
+                    node = this->m_nodes[node].left;
+                }
+            } else if (!ancestors.empty()) {
+                node = ancestors.back();
+                ancestors.pop_back();
+            } else {
+                node = Null;
+            }
+        }
+
+        return bytesRead;
+    }
+
+    std::vector<u8> PieceTable::read(u64 offset, size_t size) const {
+        std::vector<u8> result(size);
+        result.resize(this->read(offset, result.data(), result.size()));
+
+        return result;
+    }
+
+    bool PieceTable::save(File &file) const {
+        std::vector<u8> buffer(0x100000);
+
+        const auto contentSize = this->size();
+        for (u64 offset = 0; offset < contentSize; offset += buffer.size()) {
+            const auto count = size_t(std::min<u64>(buffer.size(), contentSize - offset));
+            if (this->read(offset, buffer.data(), count) != count)
+                return false;
+            if (file.writeBuffer(buffer.data(), count) != File::Result(count))
+                return false;
+        }
+
+        return true;
+    }
+
+    void PieceTable::reset() {
+        this->m_addBuffer.clear();
+        this->m_nodes.clear();
+        this->m_freeNodes.clear();
+        this->m_root = Null;
+
+        if (this->m_baseSize > 0)
+            this->m_root = this->createNode(Source::Base, 0, this->m_baseSize);
+    }
+
+    u64 PieceTable::size() const {
+        return this->m_root == Null ? 0 : this->m_nodes[this->m_root].subtreeLength;
+    }
+
+    size_t PieceTable::getPieceCount() const {
+        return this->m_nodes.size() - this->m_freeNodes.size();
+    }
+
+    void PieceTable::readFunction(PieceTable *pieceTable, void *buffer, u64 address, size_t size) {
+        auto bytes = static_cast<u8*>(buffer);
+
+        const auto bytesRead = pieceTable->read(address, bytes, size);
+        std::memset(bytes + bytesRead, 0x00, size - bytesRead);
+    }
+
+    u32 PieceTable::createNode(Source source, u64 start, u64 length) {
+        // Treap priorities only need to be well distributed, not unpredictable
+        this->m_seed ^= this->m_seed << 13;
+        this->m_seed ^= this->m_seed >> 17;
+        this->m_seed ^= this->m_seed << 5;
+
+        const Node node = { source, start, length, Null, Null, this->m_seed, length };
+
+        if (!this->m_freeNodes.empty()) {
+            const auto index = this->m_freeNodes.back();
+            this->m_freeNodes.pop_back();
+            this->m_nodes[index] = node;
+
+            return index;
+        }
+
+        this->m_nodes.push_back(node);
+        return u32(this->m_nodes.size() - 1);
+    }
+
+    void PieceTable::releaseSubtree(u32 node) {
+        if (node == Null)
+            return;
+
+        std::vector<u32> stack = { node };
+        while (!stack.empty()) {
+            const auto current = stack.back();
+            stack.pop_back();
+
+            const auto &piece = this->m_nodes[current];
+            if (piece.left != Null)
+                stack.push_back(piece.left);
+            if (piece.right != Null)
+                stack.push_back(piece.right);
+
+            this->m_freeNodes.push_back(current);
+        }
+    }
+
+    void PieceTable::update(u32 node) {
+        auto &piece = this->m_nodes[node];
+
+        piece.subtreeLength = piece.length;
+        if (piece.left != Null)
+            piece.subtreeLength += this->m_nodes[piece.left].subtreeLength;
+        if (piece.right != Null)
+            piece.subtreeLength += this->m_nodes[piece.right].subtreeLength;
+    }
+
+    u32 PieceTable::merge(u32 left, u32 right) {
+        if (left == Null)
+            return right;
+        if (right == Null)
+            return left;
+
+        if (this->m_nodes[left].priority > this->m_nodes[right].priority) {
+            const auto merged = this->merge(this->m_nodes[left].right, right);
+            this->m_nodes[left].right = merged;
+            this->update(left);
+
+            return left;
+        } else {
+            const auto merged = this->merge(left, this->m_nodes[right].left);
+            this->m_nodes[right].left = merged;
+            this->update(right);
+
+            return right;
+        }
+    }
+
+    std::pair<u32, u32> PieceTable::split(u32 node, u64 offset) {
+        if (node == Null)
+            return { Null, Null };
+
+        const auto leftChild = this->m_nodes[node].left;
+        const u64 leftLength = leftChild == Null ? 0 : this->m_nodes[leftChild].subtreeLength;
+        const u64 pieceLength = this->m_nodes[node].length;
+
+        if (offset <= leftLength) {
+            const auto [left, right] = this->split(leftChild, offset);
+            this->m_nodes[node].left = right;
+            this->update(node);
+
+            return { left, node };
+        } else if (offset >= leftLength + pieceLength) {
+            const auto [left, right] = this->split(this->m_nodes[node].right, offset - leftLength - pieceLength);
+            this->m_nodes[node].right = left;
+            this->update(node);
+
+            return { node, right };
+        } else {
+            // The offset lies inside this piece, so cut it in two. The front stays in place, the back becomes the
+            // first piece of the right half
+            const u64 cut = offset - leftLength;
+            const auto tail = this->createNode(this->m_nodes[node].source, this->m_nodes[node].start + cut, pieceLength - cut);
+
+            auto &piece = this->m_nodes[node];
+            const auto rightChild = piece.right;
+            piece.length = cut;
+            piece.right = Null;
+            this->update(node);
+
+            return { node, this->merge(tail, rightChild) };
+        }
+    }
+
+    bool PieceTable::extendLastPiece(u32 node, u64 end, u64 count) {
+        if (node == Null)
+            return false;
+
+        u32 last = node;
+        while (this->m_nodes[last].right != Null)
+            last = this->m_nodes[last].right;
+
+        const auto &piece = this->m_nodes[last];
+        if (piece.source != Source::Add || piece.start + piece.length != end)
+            return false;
+
+        for (u32 current = node; current != Null; current = this->m_nodes[current].right)
+            this->m_nodes[current].subtreeLength += count;
+        this->m_nodes[last].length += count;
+
+        return true;
+    }
+
+    size_t PieceTable::readBase(u64 address, u8 *buffer, size_t size) const {
+        if (this->m_file == nullptr) {
+            std::memcpy(buffer, this->m_baseData.data() + address, size);
+        } else if (const auto mapping = this->m_file->getMapping(); mapping != nullptr) {
+            std::memcpy(buffer, mapping + address, size);
+        } else {
+            const auto result = this->m_file->readBufferAtomic(address, buffer, size);
+            return result < 0 ? 0 : size_t(result);
+        }
+
+        return size;
+    }
+
+}
@@ -1,11 +1,16 @@
 #pragma once
 
 #include <wolv/types.hpp>
+#include <wolv/container/flat_hash_map.hpp>
+#include <wolv/container/small_vector.hpp>
+#include <wolv/container/object_pool.hpp>
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <queue>
 #include <unordered_map>
+#include <stack>
 #include <functional>
 #include <optional>
 
@@ -91,6 +96,9 @@ namespace wolv::math_eval {
             Right
         };
 
+        // Function calls rarely take more than a few arguments, keep them inline in the token
+        using Arguments = wolv::container::SmallVector<T, 4>;
+
         struct Token {
             TokenType type;
 
@@ -101,21 +109,25 @@ namespace wolv::math_eval {
             };
 
             std::string name;
-            std::vector<T> arguments;
+            Arguments arguments;
         };
 
+        // Token queues and stacks get built and torn down on every evaluation, keep their chunks in the slab pools
+        using TokenQueue = std::queue<Token, std::deque<Token, wolv::container::SlabAllocator<Token>>>;
+        using TokenStack = std::stack<Token, std::deque<Token, wolv::container::SlabAllocator<Token>>>;
+
         static i16 comparePrecedence(const Operator &a, const Operator &b);
         static bool isLeftAssociative(const Operator &op);
         static bool isUnary(const Operator &op);
         static std::pair<Operator, size_t> toOperator(const std::string &input);
 
     private:
-        std::optional<std::queue<Token>> parseInput(std::string input);
-        std::optional<std::queue<Token>> toPostfix(std::queue<Token> inputQueue);
-        std::optional<T> evaluate(std::queue<Token> postfixTokens);
+        std::optional<TokenQueue> parseInput(std::string input);
+        std::optional<TokenQueue> toPostfix(TokenQueue inputQueue);
+        std::optional<T> evaluate(TokenQueue postfixTokens);
 
         std::unordered_map<std::string, Variable> m_variables;
-        std::unordered_map<std::string, std::function<std::optional<T>(std::vector<T>)>> m_functions;
+        wolv::container::FlatHashMap<std::string, std::function<std::optional<T>(const Arguments&)>> m_functions;
 
         std::optional<std::string> m_lastError;
     };
@@ -76,9 +76,9 @@ namespace wolv::math_eval {
     }
 
     template<typename T>
-    std::optional<std::queue<typename MathEvaluator<T>::Token>> MathEvaluator<T>::toPostfix(std::queue<Token> inputQueue) {
-        std::queue<Token> outputQueue;
-        std::stack<Token> operatorStack;
+    std::optional<typename MathEvaluator<T>::TokenQueue> MathEvaluator<T>::toPostfix(TokenQueue inputQueue) {
+        TokenQueue outputQueue;
+        TokenStack operatorStack;
 
         while (!inputQueue.empty()) {
             Token currToken = inputQueue.front();
@@ -127,8 +127,8 @@ namespace wolv::math_eval {
     }
 
     template<typename T>
-    std::optional<std::queue<typename MathEvaluator<T>::Token>> MathEvaluator<T>::parseInput(std::string input) {
-        std::queue<Token> inputQueue;
+    std::optional<typename MathEvaluator<T>::TokenQueue> MathEvaluator<T>::parseInput(std::string input) {
+        TokenQueue inputQueue;
 
         char *prevPos = input.data();
         for (char *pos = prevPos; *pos != 0x00;) {
@@ -222,11 +222,11 @@ namespace wolv::math_eval {
                             if (!newInputQueue.has_value())
                                 return std::nullopt;
 
-                            auto postfixTokens = toPostfix(*newInputQueue);
+                            auto postfixTokens = toPostfix(std::move(*newInputQueue));
                             if (!postfixTokens.has_value())
                                 return std::nullopt;
 
-                            auto result = evaluate(*postfixTokens);
+                            auto result = evaluate(std::move(*postfixTokens));
                             if (!result.has_value()) {
                                 this->setError("Invalid argument for function!");
                                 return std::nullopt;
@@ -257,8 +257,8 @@ namespace wolv::math_eval {
     }
 
     template<typename T>
-    std::optional<T> MathEvaluator<T>::evaluate(std::queue<Token> postfixTokens) {
-        std::stack<T> evaluationStack;
+    std::optional<T> MathEvaluator<T>::evaluate(TokenQueue postfixTokens) {
+        std::stack<T, std::deque<T, wolv::container::SlabAllocator<T>>> evaluationStack;
 
         while (!postfixTokens.empty()) {
             auto front = postfixTokens.front();
@@ -395,19 +395,21 @@ namespace wolv::math_eval {
 
                 evaluationStack.push(result);
             } else if (front.type == TokenType::Variable) {
-                if (this->m_variables.contains(front.name))
-                    evaluationStack.push(this->m_variables.at(front.name).value);
+                auto variable = this->m_variables.find(front.name);
+                if (variable != this->m_variables.end())
+                    evaluationStack.push(variable->second.value);
                 else {
                     this->setError("Unknown variable!");
                     return std::nullopt;
                 }
             } else if (front.type == TokenType::Function) {
-                if (!this->m_functions[front.name]) {
+                auto function = this->m_functions.find(front.name);
+                if (function == this->m_functions.end() || !function->second) {
                     this->setError("Unknown function called!");
                     return std::nullopt;
                 }
 
-                auto result = this->m_functions[front.name](front.arguments);
+                auto result = function->second(front.arguments);
 
                 if (result.has_value())
                     evaluationStack.push(result.value());
@@ -452,11 +454,11 @@ namespace wolv::math_eval {
             }
         }
 
-        auto postfixTokens = toPostfix(*inputQueue);
+        auto postfixTokens = toPostfix(std::move(*inputQueue));
         if (!postfixTokens.has_value())
             return std::nullopt;
 
-        auto result = evaluate(*postfixTokens);
+        auto result = evaluate(std::move(*postfixTokens));
 
         if (result.has_value() && !this->getVariables()[resultVariable].constant)
             this->setVariable(resultVariable, result.value());
@@ -471,13 +473,13 @@ namespace wolv::math_eval {
 
     template<typename T>
     void MathEvaluator<T>::setFunction(const std::string &name, const std::function<std::optional<T>(std::vector<T>)> &function, size_t minNumArgs, size_t maxNumArgs) {
-        this->m_functions[name] = [this, minNumArgs, maxNumArgs, function](auto args) -> std::optional<T> {
+        this->m_functions[name] = [this, minNumArgs, maxNumArgs, function](const Arguments &args) -> std::optional<T> {
             if (args.size() < minNumArgs || args.size() > maxNumArgs) {
                 this->setError("Invalid number of function arguments!");
                 return std::nullopt;
             }
 
-            return function(args);
+            return function(std::vector<T>(args.begin(), args.end()));
         };
     }
 
@@ -1,6 +1,7 @@
 #include <wolv/net/socket_server.hpp>
 
 #include <wolv/utils/guards.hpp>
+#include <wolv/container/object_pool.hpp>
 
 #include <algorithm>
 #include <cstring>
@@ -122,7 +123,8 @@ namespace wolv::net {
     }
 
     void SocketServer::handleClient(SocketHandle clientSocket, bool keepAlive, const std::atomic<bool> &shouldStop, const ReadCallback &callback) const {
-        std::vector<u8> buffer(m_bufferSize);
+        // Every connection needs a receive buffer, take it from the slab pools instead of the heap
+        std::vector<u8, container::SlabAllocator<u8>> buffer(m_bufferSize);
         std::vector<u8> data;
 
         // Set socket to blocking mode with timeout
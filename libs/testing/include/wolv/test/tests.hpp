@@ -3,9 +3,9 @@
 #include <utility>
 
 #include <wolv/utils/preproc.hpp>
+#include <wolv/container/flat_hash_map.hpp>
 
 #include <string>
-#include <map>
 #include <functional>
 
 #define TEST_SEQUENCE(...) static auto WOLV_ANONYMOUS_VARIABLE(TEST_SEQUENCE) = ::wolv::test::TestSequenceExecutor(__VA_ARGS__) + []() -> int
@@ -44,7 +44,7 @@ namespace wolv::test {
         }
 
     private:
-        static inline std::map<std::string, Test> s_tests;
+        static inline wolv::container::FlatHashMap<std::string, Test> s_tests;
     };
 
     template<class F>
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+
+namespace wolv::util {
+
+    /**
+     * @brief Memory resource that hands out memory by bumping a pointer through large chunks
+     * @details Deallocating does nothing. Instead, all memory is given back at once by calling reset() or release(),
+     *          which makes it a good fit for data that lives exactly as long as a frame or a parse. Chunks are requested
+     *          from the upstream resource with geometrically growing sizes
+     * @note Not thread safe
+     */
+    class MonotonicArena : public std::pmr::memory_resource {
+    public:
+        /**
+         * @brief Creates an arena
+         * @param initialChunkSize Size of the first chunk requested from upstream
+         * @param upstream Resource the chunks are allocated from
+         */
+        explicit MonotonicArena(size_t initialChunkSize = 0x10000, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+        ~MonotonicArena() override;
+
+        MonotonicArena(const MonotonicArena &) = delete;
+        MonotonicArena& operator=(const MonotonicArena &) = delete;
+
+        /**
+         * @brief Makes all memory handed out so far available again in O(1)
+         * @details The chunks are kept, so an arena that gets reset every frame stops talking to its upstream resource
+         *          once it has grown to the size of a frame. Everything allocated from it before must not be used anymore
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Gives all chunks back to the upstream resource
+         */
+        void release() noexcept;
+
+        /**
+         * @brief Returns the number of bytes handed out since the last reset
+         */
+        [[nodiscard]] size_t getBytesUsed() const noexcept;
+
+        /**
+         * @brief Returns the number of bytes requested from the upstream resource
+         */
+        [[nodiscard]] size_t getBytesReserved() const noexcept;
+
+    private:
+        struct Chunk {
+            Chunk *next;
+            size_t size;
+        };
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *, size_t, size_t) override { }
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+        std::pmr::memory_resource *m_upstream;
+        size_t m_nextChunkSize;
+
+        Chunk *m_firstChunk = nullptr, *m_lastChunk = nullptr, *m_currentChunk = nullptr;
+        std::byte *m_cursor = nullptr, *m_end = nullptr;
+        size_t m_bytesUsedBefore = 0;
+    };
+
+    /**
+     * @brief Memory resource that keeps freed blocks in per size free lists and reuses them
+     * @details Requests are rounded up to the next power of two and served from chunks holding many blocks of that
+     *          size, so allocating and freeing a small object is a couple of pointer operations. Requests larger than
+     *          MaxBlockSize or with an alignment above alignof(std::max_align_t) go to the upstream resource directly.
+     *          Memory of the chunks is only given back to upstream by release() or when the resource is destroyed
+     * @note Not thread safe
+     */
+    class PoolResource : public std::pmr::memory_resource {
+    public:
+        constexpr static size_t MinBlockSize = sizeof(void*);
+        constexpr static size_t MaxBlockSize = 0x1000;
+
+        /**
+         * @brief Creates a pool resource
+         * @param upstream Resource the chunks and large blocks are allocated from
+         */
+        explicit PoolResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+        ~PoolResource() override;
+
+        PoolResource(const PoolResource &) = delete;
+        PoolResource& operator=(const PoolResource &) = delete;
+
+        /**
+         * @brief Gives all chunks back to the upstream resource
+         * @note Blocks larger than MaxBlockSize are owned by the upstream resource and have to be freed individually
+         */
+        void release() noexcept;
+
+    private:
+        struct Block {
+            Block *next;
+        };
+
+        struct Chunk {
+            Chunk *next;
+            size_t size;
+        };
+
+        struct Pool {
+            Block *freeList = nullptr;
+            size_t blocksPerChunk = 16;
+        };
+
+        static size_t poolIndex(size_t bytes, size_t alignment) noexcept;
+
+        void refill(size_t index);
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+        std::pmr::memory_resource *m_upstream;
+
+        std::array<Pool, std::countr_zero(MaxBlockSize) - std::countr_zero(MinBlockSize) + 1> m_pools = { };
+        Chunk *m_chunks = nullptr;
+    };
+
+}
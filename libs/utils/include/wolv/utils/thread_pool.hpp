@@ -4,10 +4,13 @@
 #include <thread>
 #include <vector>
 #include <list>
+#include <memory>
+#include <memory_resource>
 #include <functional>
 #include <condition_variable>
 
 #include <wolv/types.hpp>
+#include <wolv/container/object_pool.hpp>
 
 namespace wolv::util {
 
@@ -15,7 +18,14 @@ namespace wolv::util {
         public:
             using Task = std::function<void(const std::atomic<bool> &)>;
 
-            explicit ThreadPool(size_t threadCount) {
+            /**
+             * @brief Creates a thread pool
+             * @param threadCount Number of worker threads
+             * @param resource Memory resource the task queue is allocated from. It's only ever used while holding the
+             *                 lock of the pool, so it doesn't need to be thread safe itself. Defaults to the thread caching
+             *                 slab resource, which keeps enqueueing from many threads off the general purpose heap
+             */
+            explicit ThreadPool(size_t threadCount, std::pmr::memory_resource *resource = container::getSlabResource()) : m_tasks(resource) {
                 m_threadsAvailable = threadCount;
 
                 for (size_t i = 0; i < threadCount; i += 1) {
@@ -30,13 +40,14 @@ namespace wolv::util {
             }
 
             ThreadPool(const ThreadPool &) = delete;
-            ThreadPool(ThreadPool &&other) noexcept {
+            ThreadPool(ThreadPool &&other) noexcept : m_tasks(other.m_tasks.get_allocator().resource()) {
                 if (this != &other) {
                     other.stop();
                     this->stop();
 
                     this->m_threads.clear();
                     this->m_stop = false;
+                    this->m_tasks = std::move(other.m_tasks);
 
                     for (size_t i = 0; i < other.m_threads.size(); i += 1) {
                         this->m_threads.emplace_back([this]{
@@ -44,8 +55,6 @@ namespace wolv::util {
                         });
                     }
                     other.m_threads.clear();
-
-                    this->m_tasks = std::move(other.m_tasks);
                 }
             }
 
@@ -58,6 +67,10 @@ namespace wolv::util {
                     this->m_threads.clear();
                     this->m_stop = false;
 
+                    // pmr containers don't propagate their resource on assignment, rebuild the queue so it keeps using the one of the other pool
+                    std::destroy_at(&this->m_tasks);
+                    std::construct_at(&this->m_tasks, std::move(other.m_tasks));
+
                     for (size_t i = 0; i < other.m_threads.size(); i += 1) {
                         this->m_threads.emplace_back([this]{
                             this->waitForTasks();
@@ -65,8 +78,6 @@ namespace wolv::util {
                     }
 
                     other.m_threads.clear();
-
-                    this->m_tasks = std::move(other.m_tasks);
                 }
 
                 return *this;
@@ -75,7 +86,7 @@ namespace wolv::util {
             void enqueue(Task &&task) {
                 {
                     std::unique_lock lock(this->m_mutex);
-                    this->m_tasks.emplace_back(task);
+                    this->m_tasks.emplace_back(std::move(task));
                 }
 
                 this->m_condition.notify_one();
@@ -112,8 +123,19 @@ namespace wolv::util {
                 }
             }
 
+            /**
+             * @brief Checks if the calling thread can block until tasks it enqueues have finished
+             * @details That's not the case if the pool has no worker threads, has been stopped or if the calling thread is
+             *          one of its own workers, since the enqueued tasks might then never get to run
+             */
+            [[nodiscard]] bool canWaitForTasks() const {
+                return !this->m_threads.empty() && !this->m_stop && s_currentPool != this;
+            }
+
         private:
             void waitForTasks() {
+                s_currentPool = this;
+
                 while (true) {
                     Task task;
                     {
@@ -137,12 +159,15 @@ namespace wolv::util {
 
         private:
             std::vector<std::thread> m_threads;
-            std::list<Task> m_tasks;
+            std::pmr::list<Task> m_tasks;
 
             std::mutex m_mutex;
             std::condition_variable m_condition;
             std::atomic<bool> m_stop = false;
             std::atomic<bool> m_stopTasks = false;
             std::atomic<u32> m_threadsAvailable = 0;
+
+            // Pool the calling thread is a worker of
+            static inline thread_local const ThreadPool *s_currentPool = nullptr;
         };
 }
@@ -0,0 +1,186 @@
+#include <wolv/utils/memory_resource.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+
+namespace wolv::util {
+
+    namespace {
+
+        // Chunk headers are padded so the memory following them is suitably aligned for anything
+        template<typename Header>
+        constexpr size_t HeaderSize = (sizeof(Header) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    }
+
+    MonotonicArena::MonotonicArena(size_t initialChunkSize, std::pmr::memory_resource *upstream)
+        : m_upstream(upstream), m_nextChunkSize(std::max<size_t>(initialChunkSize, HeaderSize<Chunk> * 2)) {
+
+    }
+
+    MonotonicArena::~MonotonicArena() {
+        this->release();
+    }
+
+    void MonotonicArena::reset() noexcept {
+        this->m_currentChunk = this->m_firstChunk;
+        this->m_bytesUsedBefore = 0;
+
+        if (this->m_currentChunk == nullptr) {
+            this->m_cursor = this->m_end = nullptr;
+        } else {
+            this->m_cursor = reinterpret_cast<std::byte*>(this->m_currentChunk) + HeaderSize<Chunk>;
+            this->m_end = reinterpret_cast<std::byte*>(this->m_currentChunk) + this->m_currentChunk->size;
+        }
+    }
+
+    void MonotonicArena::release() noexcept {
+        auto chunk = this->m_firstChunk;
+        while (chunk != nullptr) {
+            const auto next = chunk->next;
+            this->m_upstream->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+            chunk = next;
+        }
+
+        this->m_firstChunk = this->m_lastChunk = nullptr;
+        this->reset();
+    }
+
+    size_t MonotonicArena::getBytesUsed() const noexcept {
+        if (this->m_currentChunk == nullptr)
+            return 0;
+
+        return this->m_bytesUsedBefore + size_t(this->m_cursor - (reinterpret_cast<std::byte*>(this->m_currentChunk) + HeaderSize<Chunk>));
+    }
+
+    size_t MonotonicArena::getBytesReserved() const noexcept {
+        size_t result = 0;
+        for (auto chunk = this->m_firstChunk; chunk != nullptr; chunk = chunk->next)
+            result += chunk->size;
+
+        return result;
+    }
+
+    void* MonotonicArena::do_allocate(size_t bytes, size_t alignment) {
+        const auto tryAllocate = [&]() -> void* {
+            void *pointer = this->m_cursor;
+            auto space = size_t(this->m_end - this->m_cursor);
+            if (this->m_cursor == nullptr || std::align(alignment, bytes, pointer, space) == nullptr)
+                return nullptr;
+
+            this->m_cursor = static_cast<std::byte*>(pointer) + bytes;
+            return pointer;
+        };
+
+        if (auto pointer = tryAllocate(); pointer != nullptr)
+            return pointer;
+
+        // Move on to the chunks kept from before the last reset, then to a new one
+        while (this->m_currentChunk != nullptr && this->m_currentChunk->next != nullptr) {
+            this->m_bytesUsedBefore += this->m_currentChunk->size - HeaderSize<Chunk>;
+            this->m_currentChunk = this->m_currentChunk->next;
+            this->m_cursor = reinterpret_cast<std::byte*>(this->m_currentChunk) + HeaderSize<Chunk>;
+            this->m_end = reinterpret_cast<std::byte*>(this->m_currentChunk) + this->m_currentChunk->size;
+
+            if (auto pointer = tryAllocate(); pointer != nullptr)
+                return pointer;
+        }
+
+        const auto size = std::max(this->m_nextChunkSize, HeaderSize<Chunk> + bytes + alignment);
+        auto chunk = static_cast<Chunk*>(this->m_upstream->allocate(size, alignof(std::max_align_t)));
+        *chunk = { nullptr, size };
+        this->m_nextChunkSize = size * 2;
+
+        if (this->m_lastChunk == nullptr)
+            this->m_firstChunk = chunk;
+        else
+            this->m_lastChunk->next = chunk;
+        this->m_lastChunk = chunk;
+
+        if (this->m_currentChunk != nullptr)
+            this->m_bytesUsedBefore += this->m_currentChunk->size - HeaderSize<Chunk>;
+        this->m_currentChunk = chunk;
+        this->m_cursor = reinterpret_cast<std::byte*>(chunk) + HeaderSize<Chunk>;
+        this->m_end = reinterpret_cast<std::byte*>(chunk) + size;
+
+        return tryAllocate();
+    }
+
+
+    PoolResource::PoolResource(std::pmr::memory_resource *upstream) : m_upstream(upstream) {
+
+    }
+
+    PoolResource::~PoolResource() {
+        this->release();
+    }
+
+    void PoolResource::release() noexcept {
+        auto chunk = this->m_chunks;
+        while (chunk != nullptr) {
+            const auto next = chunk->next;
+            this->m_upstream->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+            chunk = next;
+        }
+
+        this->m_chunks = nullptr;
+        this->m_pools = { };
+    }
+
+    size_t PoolResource::poolIndex(size_t bytes, size_t alignment) noexcept {
+        const auto blockSize = std::bit_ceil(std::max({ bytes, alignment, MinBlockSize }));
+
+        return size_t(std::countr_zero(blockSize) - std::countr_zero(MinBlockSize));
+    }
+
+    void PoolResource::refill(size_t index) {
+        auto &pool = this->m_pools[index];
+        const auto blockSize = MinBlockSize << index;
+
+        const auto size = HeaderSize<Chunk> + blockSize * pool.blocksPerChunk;
+        auto chunk = static_cast<Chunk*>(this->m_upstream->allocate(size, alignof(std::max_align_t)));
+        *chunk = { this->m_chunks, size };
+        this->m_chunks = chunk;
+
+        // Thread the new blocks onto the free list back to front, so they get handed out in address order
+        auto blocks = reinterpret_cast<std::byte*>(chunk) + HeaderSize<Chunk>;
+        for (size_t i = pool.blocksPerChunk; i > 0; i -= 1) {
+            auto block = reinterpret_cast<Block*>(blocks + (i - 1) * blockSize);
+            block->next = pool.freeList;
+            pool.freeList = block;
+        }
+
+        // Grow chunks geometrically, but don't let a single chunk get much larger than 64 KiB
+        if (blockSize * pool.blocksPerChunk * 2 <= 0x10000)
+            pool.blocksPerChunk *= 2;
+    }
+
+    void* PoolResource::do_allocate(size_t bytes, size_t alignment) {
+        if (bytes > MaxBlockSize || alignment > alignof(std::max_align_t))
+            return this->m_upstream->allocate(bytes, alignment);
+
+        const auto index = poolIndex(bytes, alignment);
+        auto &pool = this->m_pools[index];
+        if (pool.freeList == nullptr)
+            this->refill(index);
+
+        const auto block = pool.freeList;
+        pool.freeList = block->next;
+
+        return block;
+    }
+
+    void PoolResource::do_deallocate(void *pointer, size_t bytes, size_t alignment) {
+        if (bytes > MaxBlockSize || alignment > alignof(std::max_align_t)) {
+            this->m_upstream->deallocate(pointer, bytes, alignment);
+            return;
+        }
+
+        auto &pool = this->m_pools[poolIndex(bytes, alignment)];
+        const auto block = static_cast<Block*>(pointer);
+        block->next = pool.freeList;
+        pool.freeList = block;
+    }
+
+}
@@ -1,44 +1,59 @@
 #include <wolv/utils/string.hpp>
+#include <wolv/container/small_vector.hpp>
 
 #include <cmath>
 
 namespace wolv::util {
 
-    std::vector<std::string> splitString(const std::string &string, const std::string &delimiter, bool removeEmpty) {
-        if (delimiter.empty() || string.empty()) {
-            return { string };
-        }
+    namespace {
 
-        std::vector<std::string> result;
+        template<typename Container>
+        void splitStringInto(Container &result, const std::string &string, const std::string &delimiter, bool removeEmpty) {
+            if (delimiter.empty() || string.empty()) {
+                result.push_back(string);
+                return;
+            }
 
-        size_t start = 0, end = 0;
-        while ((end = string.find(delimiter, start)) != std::string::npos) {
-            size_t size = end - start;
-            if (start + size > string.length())
-                break;
+            size_t start = 0, end = 0;
+            while ((end = string.find(delimiter, start)) != std::string::npos) {
+                size_t size = end - start;
+                if (start + size > string.length())
+                    break;
 
-            auto token = string.substr(start, end - start);
-            start = end + delimiter.length();
-            result.emplace_back(std::move(token));
+                auto token = string.substr(start, end - start);
+                start = end + delimiter.length();
+                result.emplace_back(std::move(token));
+            }
+
+            if (start <= string.size())
+                result.emplace_back(string.substr(start));
+
+            if (removeEmpty)
+                result.erase(std::remove_if(result.begin(), result.end(), [](const auto &string) { return string.empty(); }), result.end());
         }
 
-        if (start <= string.size())
-            result.emplace_back(string.substr(start));
+        template<typename Container>
+        std::string combineStringsOf(const Container &strings, const std::string &delimiter) {
+            std::string result;
+            for (const auto &string : strings) {
+                result += string;
+                result += delimiter;
+            }
 
-        if (removeEmpty)
-            std::erase_if(result, [](const auto &string) { return string.empty(); });
+            return result.substr(0, result.length() - delimiter.length());
+        }
+
+    }
+
+    std::vector<std::string> splitString(const std::string &string, const std::string &delimiter, bool removeEmpty) {
+        std::vector<std::string> result;
+        splitStringInto(result, string, delimiter, removeEmpty);
 
         return result;
     }
 
     std::string combineStrings(const std::vector<std::string> &strings, const std::string &delimiter) {
-        std::string result;
-        for (const auto &string : strings) {
-            result += string;
-            result += delimiter;
-        }
-
-        return result.substr(0, result.length() - delimiter.length());
+        return combineStringsOf(strings, delimiter);
     }
 
     std::string replaceStrings(std::string string, const std::string &search, const std::string &replace) {
@@ -132,15 +147,17 @@ namespace wolv::util {
     }
 
     std::string capitalizeString(std::string string) {
-        for (const auto delimiter : { "_", "-", " " }) {
-            auto parts = splitString(string, delimiter);
+        for (const std::string delimiter : { "_", "-", " " }) {
+            // Most names only consist of a few words, so keep the parts inline
+            container::SmallVector<std::string, 4> parts;
+            splitStringInto(parts, string, delimiter, false);
 
             for (auto &part : parts) {
                 if (!part.empty())
                     part[0] = char(std::toupper(part[0]));
             }
 
-            string = combineStrings(parts, delimiter);
+            string = combineStringsOf(parts, delimiter);
         }
 
         return string;
@@ -0,0 +1,153 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/concurrent_ring_buffer.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+TEST_SEQUENCE("SpscRingBuffer") {
+    wolv::container::SpscRingBuffer<std::string> buffer(3);
+    TEST_ASSERT(buffer.capacity() == 4);
+
+    for (u32 i = 0; i < 4; i++)
+        TEST_ASSERT(buffer.tryPush(std::to_string(i)));
+    TEST_ASSERT(!buffer.tryPush("full"));
+    TEST_ASSERT(buffer.size() == 4);
+
+    std::string item;
+    TEST_ASSERT(buffer.tryPop(item) && item == "0");
+    TEST_ASSERT(buffer.tryEmplace(3, 'x'));
+
+    for (const auto expected : { "1", "2", "3", "xxx" })
+        TEST_ASSERT(buffer.tryPop(item) && item == expected);
+    TEST_ASSERT(!buffer.tryPop(item));
+    TEST_ASSERT(buffer.empty());
+
+    // Hand over lots of elements between two threads through a tiny buffer, so both sides have to wait on each other
+    constexpr static u64 Count = 200000;
+    wolv::container::SpscRingBuffer<u64> numbers(16);
+
+    std::thread producer([&numbers] {
+        for (u64 i = 0; i < Count; i++)
+            numbers.push(i);
+    });
+
+    bool ordered = true;
+    for (u64 i = 0; i < Count; i++) {
+        u64 value;
+        numbers.pop(value);
+        ordered = ordered && value == i;
+    }
+    producer.join();
+
+    TEST_ASSERT(ordered);
+    TEST_ASSERT(numbers.empty());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("MpmcRingBuffer") {
+    wolv::container::MpmcRingBuffer<std::unique_ptr<u32>> buffer(1);
+    TEST_ASSERT(buffer.capacity() == 2);
+
+    TEST_ASSERT(buffer.tryPush(std::make_unique<u32>(1)));
+    TEST_ASSERT(buffer.tryPush(std::make_unique<u32>(2)));
+    TEST_ASSERT(!buffer.tryPush(std::make_unique<u32>(3)));
+
+    std::unique_ptr<u32> item;
+    TEST_ASSERT(buffer.tryPop(item) && *item == 1);
+    TEST_ASSERT(buffer.tryPop(item) && *item == 2);
+    TEST_ASSERT(!buffer.tryPop(item));
+
+    // Leftover elements get destroyed together with the buffer
+    TEST_ASSERT(buffer.tryPush(std::make_unique<u32>(4)));
+
+    // Every value pushed by any producer has to be popped exactly once by one of the consumers
+    constexpr static u32 Threads = 4;
+    constexpr static u64 CountPerThread = 50000;
+    wolv::container::MpmcRingBuffer<u64> numbers(64);
+
+    std::vector<std::atomic<u32>> seen(Threads * CountPerThread);
+    std::vector<std::thread> threads;
+    for (u32 thread = 0; thread < Threads; thread++) {
+        threads.emplace_back([&numbers, thread] {
+            for (u64 i = 0; i < CountPerThread; i++)
+                numbers.push(thread * CountPerThread + i);
+        });
+
+        threads.emplace_back([&numbers, &seen] {
+            for (u64 i = 0; i < CountPerThread; i++) {
+                u64 value;
+                numbers.pop(value);
+                seen[value].fetch_add(1);
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    bool allSeenOnce = true;
+    for (const auto &count : seen)
+        allSeenOnce = allSeenOnce && count.load() == 1;
+
+    TEST_ASSERT(allSeenOnce);
+    TEST_ASSERT(numbers.empty());
+
+    TEST_SUCCESS();
+};
+
+// Makes both sides actually go to sleep on a full or empty buffer, the spinning in front of it only lasts a few cycles
+template<typename Buffer>
+static bool wakesUpBlockedThreads() {
+    using namespace std::chrono_literals;
+
+    Buffer buffer(2);
+    std::atomic<bool> done = false;
+
+    std::thread consumer([&buffer, &done] {
+        u32 value;
+        buffer.pop(value);
+        done = value == 1;
+    });
+
+    std::this_thread::sleep_for(50ms);
+    if (done)
+        return false;
+
+    buffer.push(1);
+    consumer.join();
+    if (!done)
+        return false;
+
+    done = false;
+    while (buffer.tryPush(2)) { }
+
+    std::thread producer([&buffer, &done] {
+        buffer.push(3);
+        done = true;
+    });
+
+    std::this_thread::sleep_for(50ms);
+    if (done)
+        return false;
+
+    u32 value;
+    buffer.pop(value);
+    producer.join();
+
+    return done && buffer.size() == buffer.capacity();
+}
+
+TEST_SEQUENCE("ConcurrentRingBuffer_Blocking") {
+    TEST_ASSERT(wakesUpBlockedThreads<wolv::container::SpscRingBuffer<u32>>());
+    TEST_ASSERT(wakesUpBlockedThreads<wolv::container::MpmcRingBuffer<u32>>());
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,137 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/flat_hash_map.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+// Keys can't be modified through iterators, that would leave them in the wrong slot
+static_assert(std::is_const_v<std::remove_reference_t<decltype(wolv::container::FlatHashMap<std::string, u32>::iterator()->first)>>);
+static_assert(std::is_const_v<std::remove_reference_t<decltype(*wolv::container::FlatHashSet<std::string>::iterator())>>);
+
+TEST_SEQUENCE("FlatHashMap_Basic") {
+    wolv::container::FlatHashMap<std::string, u32> map = {
+        { "one", 1 },
+        { "two", 2 },
+    };
+
+    TEST_ASSERT(map.size() == 2);
+    TEST_ASSERT(map.at("one") == 1);
+
+    // Lookups with string views and literals don't need a std::string
+    const std::string_view key = "two";
+    TEST_ASSERT(map.contains(key));
+    TEST_ASSERT(map.find(key)->second == 2);
+    TEST_ASSERT(!map.contains("three"));
+    TEST_ASSERT(map.find("three") == map.end());
+
+    map["three"] = 3;
+    map[std::string("four")] += 4;
+    TEST_ASSERT(map.size() == 4);
+    TEST_ASSERT(map.at(std::string_view("three")) == 3 && map.at("four") == 4);
+
+    TEST_ASSERT(!map.insert({ "one", 100 }).second);
+    TEST_ASSERT(map.insertOrAssign("one", 100).first->second == 100);
+    TEST_ASSERT(map.tryEmplace("five", 5u).second);
+
+    bool thrown = false;
+    try {
+        (void)map.at("six");
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    TEST_ASSERT(thrown);
+
+    TEST_ASSERT(map.erase("two") == 1);
+    TEST_ASSERT(map.erase("two") == 0);
+    TEST_ASSERT(!map.contains("two"));
+
+    u32 sum = 0;
+    for (const auto &[name, value] : map)
+        sum += value;
+    TEST_ASSERT(sum == 100 + 3 + 4 + 5);
+
+    auto copy = map;
+    auto moved = std::move(map);
+    TEST_ASSERT(copy.size() == 4 && moved.size() == 4);
+    TEST_ASSERT(copy.at("five") == 5 && moved.at("five") == 5);
+
+    moved.clear();
+    TEST_ASSERT(moved.empty());
+    TEST_ASSERT(moved.begin() == moved.end());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("FlatHashMap_Random") {
+    std::mt19937 generator(99);
+
+    wolv::container::FlatHashMap<u64, u64> map;
+    std::unordered_map<u64, u64> reference;
+
+    // A small key range causes lots of erasing and reinserting, so tombstones have to be cleaned up properly
+    for (u32 i = 0; i < 200000; i++) {
+        const auto key = std::uniform_int_distribution<u64>(0, 5000)(generator);
+
+        switch (std::uniform_int_distribution<u32>(0, 2)(generator)) {
+            case 0:
+                map[key] = i;
+                reference[key] = i;
+                break;
+            case 1:
+                TEST_ASSERT(map.erase(key) == reference.erase(key));
+                break;
+            case 2: {
+                const auto iter = map.find(key);
+                const auto expected = reference.find(key);
+                TEST_ASSERT((iter == map.end()) == (expected == reference.end()));
+                TEST_ASSERT(iter == map.end() || iter->second == expected->second);
+                break;
+            }
+        }
+    }
+
+    TEST_ASSERT(map.size() == reference.size());
+
+    size_t visited = 0;
+    for (const auto &[key, value] : map) {
+        TEST_ASSERT(reference.at(key) == value);
+        visited += 1;
+    }
+    TEST_ASSERT(visited == reference.size());
+
+    // Erasing while iterating
+    for (auto iter = map.begin(); iter != map.end(); ) {
+        if (iter->first % 2 == 0)
+            iter = map.erase(iter);
+        else
+            ++iter;
+    }
+    std::erase_if(reference, [](const auto &item) { return item.first % 2 == 0; });
+    TEST_ASSERT(map.size() == reference.size());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("FlatHashSet") {
+    wolv::container::FlatHashSet<std::string> set;
+    for (u32 i = 0; i < 1000; i++)
+        TEST_ASSERT(set.insert(std::to_string(i)).second);
+
+    TEST_ASSERT(!set.insert("10").second);
+    TEST_ASSERT(set.size() == 1000);
+    TEST_ASSERT(set.capacity() >= 1000);
+    TEST_ASSERT(set.contains(std::string_view("999")));
+    TEST_ASSERT(!set.contains("1000"));
+
+    set.reserve(5000);
+    TEST_ASSERT(set.size() == 1000 && set.contains("123"));
+
+    TEST_SUCCESS();
+};
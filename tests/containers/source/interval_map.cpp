@@ -0,0 +1,132 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/interval_map.hpp>
+
+#include <array>
+#include <limits>
+#include <optional>
+#include <random>
+
+using namespace wolv::unsigned_integers;
+
+namespace {
+
+    using Map = wolv::container::IntervalMap<u32>;
+
+    // Checks the map against a plain array of values and makes sure touching segments with equal values got merged
+    template<size_t Size>
+    bool matches(const Map &map, const std::array<std::optional<u32>, Size> &reference) {
+        for (u64 address = 0; address < Size; address++) {
+            if (map.at(address) != reference[address])
+                return false;
+        }
+
+        const Map::Segment *previous = nullptr;
+        for (const auto &segment : map) {
+            if (segment.interval.start > segment.interval.end)
+                return false;
+
+            if (previous != nullptr) {
+                if (previous->interval.end >= segment.interval.start)
+                    return false;
+                if (previous->interval.end + 1 == segment.interval.start && previous->value == segment.value)
+                    return false;
+            }
+
+            previous = &segment;
+        }
+
+        return true;
+    }
+
+}
+
+TEST_SEQUENCE("IntervalMap_Basic") {
+    Map map = {
+        { { 0, 9 },   1 },
+        { { 20, 29 }, 2 },
+    };
+
+    TEST_ASSERT(map.size() == 2);
+    TEST_ASSERT(map.at(5) == 1);
+    TEST_ASSERT(!map.contains(15));
+
+    // Assigning into the middle of a segment splits it
+    map.assign({ 3, 5 }, 3);
+    TEST_ASSERT(map.size() == 4);
+    TEST_ASSERT(map.at(2) == 1 && map.at(3) == 3 && map.at(5) == 3 && map.at(6) == 1);
+    TEST_ASSERT(map.find(6)->interval.start == 6 && map.find(6)->interval.end == 9);
+
+    // Assigning the same value again merges everything back together
+    map.assign({ 3, 5 }, 1);
+    TEST_ASSERT(map.size() == 2);
+    TEST_ASSERT(map.find(4)->interval.start == 0 && map.find(4)->interval.end == 9);
+
+    // Filling the gap joins touching segments with equal values
+    map.assign({ 10, 19 }, 2);
+    TEST_ASSERT(map.size() == 2);
+    TEST_ASSERT(map.find(15)->interval.start == 10 && map.find(15)->interval.end == 29);
+
+    map.erase({ 5, 24 });
+    TEST_ASSERT(map.size() == 2);
+    TEST_ASSERT(map.at(4) == 1 && !map.contains(5) && !map.contains(24) && map.at(25) == 2);
+
+    const auto segments = map.overlapping({ 4, 25 });
+    TEST_ASSERT(segments.size() == 2);
+    TEST_ASSERT(segments[0].value == 1 && segments[1].value == 2);
+
+    map.modify({ 0, 27 }, [](u32 &value) { value = 7; });
+    TEST_ASSERT(map.size() == 3);
+    TEST_ASSERT(map.at(0) == 7 && map.at(27) == 7 && map.at(28) == 2);
+
+    // Intervals reaching the end of the address space
+    wolv::container::IntervalMap<u32, u8> edges;
+    edges.assign({ 0, 255 }, 1);
+    edges.assign({ 128, 255 }, 2);
+    TEST_ASSERT(edges.size() == 2 && edges.at(255) == 2 && edges.at(127) == 1);
+    edges.assign({ 100, 255 }, 1);
+    TEST_ASSERT(edges.size() == 1 && edges.find(255)->interval.start == 0);
+    edges.erase({ 0, 255 });
+    TEST_ASSERT(edges.empty());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("IntervalMap_Random") {
+    std::mt19937 generator(4242);
+
+    constexpr static size_t Size = 512;
+    std::array<std::optional<u32>, Size> reference = { };
+    Map map;
+
+    for (u32 i = 0; i < 3000; i++) {
+        const auto start = std::uniform_int_distribution<u64>(0, Size - 1)(generator);
+        const auto end = std::min<u64>(Size - 1, start + std::uniform_int_distribution<u64>(0, 40)(generator));
+        const auto value = std::uniform_int_distribution<u32>(0, 3)(generator);
+
+        switch (std::uniform_int_distribution<u32>(0, 3)(generator)) {
+            case 0:
+            case 1:
+                map.assign({ start, end }, value);
+                for (auto address = start; address <= end; address++)
+                    reference[address] = value;
+                break;
+            case 2:
+                map.erase({ start, end });
+                for (auto address = start; address <= end; address++)
+                    reference[address].reset();
+                break;
+            case 3:
+                map.modify({ start, end }, [](u32 &stored) { stored = (stored + 1) % 4; });
+                for (auto address = start; address <= end; address++) {
+                    if (reference[address].has_value())
+                        reference[address] = (*reference[address] + 1) % 4;
+                }
+                break;
+        }
+
+        TEST_ASSERT(matches(map, reference));
+    }
+
+    TEST_SUCCESS();
+};
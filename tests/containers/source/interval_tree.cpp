@@ -0,0 +1,539 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/interval_tree.hpp>
+#include <wolv/container/concurrent_interval_tree.hpp>
+#include <wolv/container/ring_buffer.hpp>
+#include <wolv/utils/memory_resource.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+namespace {
+
+    using Tree = wolv::container::IntervalTree<u32>;
+
+    struct Reference {
+        std::vector<std::pair<Tree::Interval, u32>> intervals;
+
+        [[nodiscard]] std::vector<u32> overlapping(const Tree::Interval &interval) const {
+            std::vector<u32> result;
+            for (const auto &[stored, value] : this->intervals) {
+                if (stored.overlaps(interval))
+                    result.push_back(value);
+            }
+
+            std::ranges::sort(result);
+            return result;
+        }
+    };
+
+    std::vector<u32> values(const std::vector<Tree::Data> &data) {
+        std::vector<u32> result;
+        for (const auto &item : data)
+            result.push_back(item.value);
+
+        std::ranges::sort(result);
+        return result;
+    }
+
+    Tree::Interval randomInterval(std::mt19937 &generator, u64 maxAddress, u64 maxSize) {
+        const auto start = std::uniform_int_distribution<u64>(0, maxAddress)(generator);
+        const auto size  = std::uniform_int_distribution<u64>(0, maxSize)(generator);
+
+        return { start, start + size };
+    }
+
+    // Computes the merged union of all intervals overlapping the query, clipped to it, one address at a time
+    std::vector<Tree::Interval> coverage(const Reference &reference, const Tree::Interval &interval) {
+        std::vector<bool> covered(interval.end - interval.start + 1);
+        for (const auto &[stored, value] : reference.intervals) {
+            if (!stored.overlaps(interval))
+                continue;
+
+            for (auto address = std::max(stored.start, interval.start); address <= std::min(stored.end, interval.end); address++)
+                covered[address - interval.start] = true;
+        }
+
+        std::vector<Tree::Interval> result;
+        for (u64 offset = 0; offset < covered.size(); offset++) {
+            if (!covered[offset])
+                continue;
+
+            if (!result.empty() && result.back().end + 1 == interval.start + offset)
+                result.back().end += 1;
+            else
+                result.push_back({ interval.start + offset, interval.start + offset });
+        }
+
+        return result;
+    }
+
+    bool checkAggregates(const Tree &tree, const Reference &reference, const Tree::Interval &interval) {
+        const auto expected = coverage(reference, interval);
+
+        std::vector<Tree::Interval> merged;
+        for (const auto &segment : tree.mergedOverlapping(interval))
+            merged.push_back(segment);
+
+        u64 coveredLength = 0;
+        for (const auto &segment : expected)
+            coveredLength += segment.end - segment.start + 1;
+
+        return tree.count(interval) == reference.overlapping(interval).size() &&
+               tree.coveredLength(interval) == coveredLength &&
+               std::ranges::equal(merged, expected, [](const auto &left, const auto &right) {
+                   return left.start == right.start && left.end == right.end;
+               });
+    }
+
+}
+
+TEST_SEQUENCE("IntervalTree_Basic") {
+    Tree tree = {
+        { { 0, 5 }, 69   },
+        { { 1, 3 }, 420  },
+        { { 2, 4 }, 1337 },
+        { { 3, 6 }, 9001 },
+        { { 6, 8 }, 8008 },
+    };
+
+    TEST_ASSERT(tree.size() == 5);
+
+    const auto result = tree.overlapping({ 4, 5 });
+    TEST_ASSERT(result.size() == 3);
+
+    // Results are sorted by descending start address
+    TEST_ASSERT(result[0].value == 9001);
+    TEST_ASSERT(result[1].value == 1337);
+    TEST_ASSERT(result[2].value == 69);
+
+    TEST_ASSERT(tree.nextInterval(2)->value == 9001);
+    TEST_ASSERT(tree.prevInterval(2)->value == 420);
+    TEST_ASSERT(!tree.nextInterval(6).has_value());
+    TEST_ASSERT(!tree.prevInterval(0).has_value());
+
+    tree.clear();
+    TEST_ASSERT(tree.empty());
+    TEST_ASSERT(tree.overlapping({ 0, 10 }).empty());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("IntervalTree_Incremental") {
+    std::mt19937 generator(1337);
+
+    Tree tree;
+    Reference reference;
+
+    // Interleave inserts and queries so queries see the tree in every state of the index
+    for (u32 i = 0; i < 3000; i++) {
+        const auto interval = randomInterval(generator, 100000, 500);
+        tree.insert(interval, i);
+        reference.intervals.emplace_back(interval, i);
+
+        const auto query = randomInterval(generator, 100000, 2000);
+        TEST_ASSERT(values(tree.overlapping(query)) == reference.overlapping(query));
+    }
+
+    TEST_ASSERT(tree.size() == reference.intervals.size());
+
+    for (u32 i = 0; i < 200; i++) {
+        const auto address = std::uniform_int_distribution<u64>(0, 100000)(generator);
+
+        std::optional<Tree::Interval> expectedNext, expectedPrev;
+        for (const auto &[interval, value] : reference.intervals) {
+            if (interval.start > address && (!expectedNext || interval.start < expectedNext->start))
+                expectedNext = interval;
+            if (interval.start < address && (!expectedPrev || interval.start > expectedPrev->start))
+                expectedPrev = interval;
+        }
+
+        const auto next = tree.nextInterval(address);
+        const auto prev = tree.prevInterval(address);
+        TEST_ASSERT(next.has_value() == expectedNext.has_value());
+        TEST_ASSERT(prev.has_value() == expectedPrev.has_value());
+        TEST_ASSERT(!next || next->interval.start == expectedNext->start);
+        TEST_ASSERT(!prev || prev->interval.start == expectedPrev->start);
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("IntervalTree_Erase") {
+    std::mt19937 generator(420);
+
+    Tree tree;
+    std::vector<std::pair<Tree::Handle, u32>> handles;
+    Reference reference;
+
+    const auto eraseFromReference = [&reference](u32 value) {
+        std::erase_if(reference.intervals, [value](const auto &item) { return item.second == value; });
+    };
+
+    for (u32 i = 0; i < 5000; i++) {
+        const auto action = std::uniform_int_distribution<u32>(0, 9)(generator);
+
+        if (action < 6 || handles.empty()) {
+            const auto interval = randomInterval(generator, 50000, 300);
+            handles.emplace_back(tree.insert(interval, i), i);
+            reference.intervals.emplace_back(interval, i);
+        } else if (action < 9) {
+            const auto index = std::uniform_int_distribution<size_t>(0, handles.size() - 1)(generator);
+            const auto [handle, value] = handles[index];
+
+            TEST_ASSERT(tree.contains(handle));
+            TEST_ASSERT(tree.at(handle) == value);
+            TEST_ASSERT(tree.erase(handle));
+            TEST_ASSERT(!tree.contains(handle));
+            TEST_ASSERT(!tree.erase(handle));
+
+            handles.erase(handles.begin() + index);
+            eraseFromReference(value);
+        } else {
+            // Replace the value in place and make sure queries see the new one
+            const auto index = std::uniform_int_distribution<size_t>(0, handles.size() - 1)(generator);
+            auto &[handle, value] = handles[index];
+
+            const auto newValue = value + 1'000'000;
+            TEST_ASSERT(tree.update(handle, newValue));
+            for (auto &item : reference.intervals) {
+                if (item.second == value)
+                    item.second = newValue;
+            }
+            value = newValue;
+        }
+
+        const auto query = randomInterval(generator, 50000, 1000);
+        TEST_ASSERT(values(tree.overlapping(query)) == reference.overlapping(query));
+        TEST_ASSERT(tree.size() == reference.intervals.size());
+    }
+
+    // Erasing by exact interval and by predicate
+    tree.clear();
+    tree.insert({ 10, 20 }, 1);
+    tree.insert({ 10, 20 }, 2);
+    tree.insert({ 10, 21 }, 3);
+    for (u32 i = 0; i < 100; i++)
+        tree.insert({ 100 + i, 200 + i }, 100 + i);
+
+    TEST_ASSERT(tree.erase(Tree::Interval { 10, 20 }) == 2);
+    TEST_ASSERT(tree.erase(Tree::Interval { 10, 20 }) == 0);
+    TEST_ASSERT(values(tree.overlapping({ 0, 50 })) == std::vector<u32>{ 3 });
+
+    const auto erasedCount = tree.eraseIf([](const Tree::Interval &, u32 value) { return value % 2 == 0; });
+    TEST_ASSERT(erasedCount == 50);
+    TEST_ASSERT(tree.size() == 51);
+    TEST_ASSERT(tree.nextInterval(100)->value == 101);
+    TEST_ASSERT(tree.prevInterval(200)->value == 199);
+
+    std::vector<u32> remaining;
+    for (const auto &[interval, value] : tree)
+        remaining.push_back(value);
+    std::ranges::sort(remaining);
+    TEST_ASSERT(remaining.size() == 51 && remaining.front() == 3 && remaining.back() == 199);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("IntervalTree_Visitor") {
+    std::mt19937 generator(9001);
+
+    Tree tree;
+    Reference reference;
+    for (u32 i = 0; i < 2000; i++) {
+        const auto interval = randomInterval(generator, 100000, 400);
+        tree.insert(interval, i);
+        reference.intervals.emplace_back(interval, i);
+    }
+
+    std::vector<Tree::Data> buffer;
+    for (u32 i = 0; i < 500; i++) {
+        const auto query = randomInterval(generator, 100000, 1000);
+        const auto expected = reference.overlapping(query);
+
+        std::vector<u32> visited;
+        tree.forEachOverlapping(query, [&visited](const Tree::Data &data) {
+            visited.push_back(data.value);
+        });
+        std::ranges::sort(visited);
+        TEST_ASSERT(visited == expected);
+
+        // Reused buffers keep their previous contents
+        buffer.clear();
+        buffer.push_back({ { 0, 0 }, 0xFFFF'FFFF });
+        tree.overlapping(query, buffer);
+        TEST_ASSERT(buffer.size() == expected.size() + 1);
+        TEST_ASSERT(buffer.front().value == 0xFFFF'FFFF);
+        buffer.erase(buffer.begin());
+        TEST_ASSERT(values(buffer) == expected);
+
+        TEST_ASSERT(tree.anyOverlapping(query) == !expected.empty());
+
+        const auto first = tree.firstOverlapping(query);
+        TEST_ASSERT(first.has_value() == !expected.empty());
+        if (first.has_value()) {
+            for (const auto &[interval, value] : reference.intervals) {
+                if (interval.overlaps(query))
+                    TEST_ASSERT(first->interval.start <= interval.start);
+            }
+        }
+
+        // Returning false from the callback stops the search right away
+        u32 calls = 0;
+        tree.forEachOverlapping(query, [&calls](const Tree::Data &) {
+            calls += 1;
+            return false;
+        });
+        TEST_ASSERT(calls == std::min<size_t>(1, expected.size()));
+    }
+
+    TEST_ASSERT(!Tree().anyOverlapping({ 0, 100 }));
+    TEST_ASSERT(!Tree().firstOverlapping({ 0, 100 }).has_value());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("IntervalTree_BulkLoad") {
+    std::mt19937 generator(69);
+
+    std::vector<Tree::InitType> sorted;
+    for (u32 i = 0; i < 20000; i++)
+        sorted.push_back({ randomInterval(generator, 1'000'000, 100), i });
+    std::ranges::sort(sorted, [](const auto &left, const auto &right) {
+        return std::pair(left.interval.start, left.interval.end) < std::pair(right.interval.start, right.interval.end);
+    });
+
+    Reference reference;
+    for (const auto &[interval, value] : sorted)
+        reference.intervals.emplace_back(interval, value);
+
+    Tree tree;
+    tree.insert({ 0, 10 }, 0xFFFF'FFFF);
+    tree.bulkLoad(sorted, true);
+    TEST_ASSERT(tree.size() == sorted.size());
+
+    for (u32 i = 0; i < 200; i++) {
+        const auto query = randomInterval(generator, 1'000'000, 5000);
+        TEST_ASSERT(values(tree.overlapping(query)) == reference.overlapping(query));
+    }
+
+    // Claiming unsorted input is sorted must not corrupt the index
+    std::vector<std::pair<Tree::Interval, u32>> unsorted(reference.intervals.rbegin(), reference.intervals.rend());
+    Tree unsortedTree;
+    unsortedTree.bulkLoad(unsorted, true);
+    for (u32 i = 0; i < 200; i++) {
+        const auto query = randomInterval(generator, 1'000'000, 5000);
+        TEST_ASSERT(values(unsortedTree.overlapping(query)) == reference.overlapping(query));
+    }
+
+    // Batches get merged into an index that already contains runs, pending and erased intervals
+    for (u32 batch = 0; batch < 10; batch++) {
+        for (u32 i = 0; i < 37; i++) {
+            const auto interval = randomInterval(generator, 1'000'000, 100);
+            const auto value = 100'000 + batch * 1000 + i;
+            const auto handle = tree.insert(interval, value);
+
+            if (i % 5 == 0)
+                tree.erase(handle);
+            else
+                reference.intervals.emplace_back(interval, value);
+        }
+
+        std::vector<Tree::InitType> items;
+        for (u32 i = 0; i < 500; i++) {
+            const auto interval = randomInterval(generator, 1'000'000, 100);
+            const auto value = 200'000 + batch * 1000 + i;
+            items.push_back({ interval, value });
+            reference.intervals.emplace_back(interval, value);
+        }
+        tree.insert(std::move(items));
+
+        TEST_ASSERT(tree.size() == reference.intervals.size());
+        for (u32 i = 0; i < 50; i++) {
+            const auto query = randomInterval(generator, 1'000'000, 5000);
+            TEST_ASSERT(values(tree.overlapping(query)) == reference.overlapping(query));
+        }
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("IntervalTree_Concurrent") {
+    constexpr u32 IntervalCount = 200;
+    constexpr u32 VersionCount = 200;
+
+    wolv::container::ConcurrentIntervalTree<u32> tree;
+
+    // Every published version contains exactly IntervalCount intervals, all tagged with the version number
+    const auto publishVersion = [&tree](u32 version) {
+        tree.modify([version](Tree &current) {
+            current.eraseIf([](const Tree::Interval &, u32) { return true; });
+            for (u32 i = 0; i < IntervalCount; i++)
+                current.insert({ i * 10, i * 10 + 5 }, version);
+        });
+    };
+
+    publishVersion(0);
+
+    std::atomic<bool> done = false;
+    std::atomic<bool> consistent = true;
+    std::vector<std::jthread> readers;
+    for (u32 reader = 0; reader < 4; reader++) {
+        readers.emplace_back([&] {
+            u32 lastVersion = 0;
+            std::vector<Tree::Data> buffer;
+
+            while (!done) {
+                const auto snapshot = tree.snapshot();
+
+                buffer.clear();
+                snapshot->overlapping({ 0, IntervalCount * 10 }, buffer);
+
+                const auto version = buffer.empty() ? 0 : buffer.front().value;
+                const auto sameVersion = std::ranges::all_of(buffer, [version](const Tree::Data &data) { return data.value == version; });
+                if (buffer.size() != IntervalCount || !sameVersion || version < lastVersion)
+                    consistent = false;
+
+                lastVersion = version;
+            }
+        });
+    }
+
+    const auto oldSnapshot = tree.snapshot();
+    for (u32 version = 1; version <= VersionCount; version++)
+        publishVersion(version);
+
+    done = true;
+    readers.clear();
+
+    TEST_ASSERT(consistent.load());
+
+    // Old snapshots are unaffected by later modifications
+    TEST_ASSERT(oldSnapshot->size() == IntervalCount);
+    TEST_ASSERT(oldSnapshot->firstOverlapping({ 0, 0 })->value == 0);
+    TEST_ASSERT(tree.snapshot()->firstOverlapping({ 0, 0 })->value == VersionCount);
+
+    tree.publish(Tree());
+    TEST_ASSERT(tree.snapshot()->empty());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("IntervalTree_Aggregates") {
+    std::mt19937 generator(7331);
+
+    Tree tree;
+    Reference reference;
+    std::vector<Tree::Handle> handles;
+
+    const auto checkQueries = [&] {
+        for (u32 i = 0; i < 200; i++) {
+            if (!checkAggregates(tree, reference, randomInterval(generator, 5000, 300)))
+                return false;
+        }
+
+        return checkAggregates(tree, reference, { 0, 6000 });
+    };
+
+    // Runs of different sizes plus a partially filled insertion buffer
+    for (u32 i = 0; i < 1000; i++) {
+        const auto interval = randomInterval(generator, 5000, 20);
+        handles.push_back(tree.insert(interval, i));
+        reference.intervals.emplace_back(interval, i);
+    }
+    TEST_ASSERT(checkQueries());
+
+    // Erased intervals are still part of the index until it gets compacted
+    for (u32 i = 0; i < 1000; i += 3) {
+        tree.erase(handles[i]);
+        std::erase_if(reference.intervals, [i](const auto &item) { return item.second == i; });
+    }
+    TEST_ASSERT(checkQueries());
+
+    tree.compact();
+    TEST_ASSERT(checkQueries());
+
+    const auto interval = randomInterval(generator, 5000, 20);
+    tree.insert(interval, 5000);
+    reference.intervals.emplace_back(interval, 5000);
+    TEST_ASSERT(checkQueries());
+
+    tree.bulkLoad(reference.intervals);
+    TEST_ASSERT(checkQueries());
+
+    // Touching intervals are joined, the result is clipped to the query
+    Tree touching = {
+        { { 0, 4 }, 1 },
+        { { 5, 9 }, 2 },
+        { { 20, 29 }, 3 },
+    };
+    touching.compact();
+
+    const auto segments = [](const Tree &tree, const Tree::Interval &interval) {
+        std::vector<std::pair<u64, u64>> result;
+        for (const auto &segment : tree.mergedOverlapping(interval))
+            result.emplace_back(segment.start, segment.end);
+
+        return result;
+    };
+
+    using Segments = std::vector<std::pair<u64, u64>>;
+    TEST_ASSERT(segments(touching, { 2, 25 }) == Segments({ { 2, 9 }, { 20, 25 } }));
+    TEST_ASSERT(touching.coveredLength({ 2, 25 }) == 14);
+    TEST_ASSERT(touching.count({ 9, 20 }) == 2);
+    TEST_ASSERT(touching.count({ 10, 19 }) == 0);
+    TEST_ASSERT(segments(touching, { 10, 19 }).empty());
+
+    // Covering every address wraps around
+    wolv::container::IntervalTree<u32, u8> full = { { { 0, 100 }, 1 }, { { 101, 255 }, 2 } };
+    TEST_ASSERT(full.coveredLength({ 0, 255 }) == 0);
+    TEST_ASSERT(full.coveredLength({ 1, 255 }) == 255);
+
+    full.compact();
+    TEST_ASSERT(full.coveredLength({ 0, 255 }) == 0);
+    TEST_ASSERT(full.coveredLength({ 1, 255 }) == 255);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("IntervalTree_Allocator") {
+    wolv::util::MonotonicArena arena;
+
+    {
+        Tree tree(&arena);
+        Reference reference;
+        TEST_ASSERT(tree.getResource() == &arena);
+
+        std::mt19937 random(42);
+        for (u32 i = 0; i < 1000; i++) {
+            const auto start = random() % 10000;
+            const Tree::Interval interval = { start, start + random() % 100 };
+
+            tree.insert(interval, i);
+            reference.intervals.push_back({ interval, i });
+        }
+        tree.compact();
+
+        TEST_ASSERT(arena.getBytesUsed() > 0);
+        for (u32 i = 0; i < 100; i++) {
+            const auto start = random() % 10000;
+            const Tree::Interval query = { start, start + 50 };
+            TEST_ASSERT(values(tree.overlapping(query)) == reference.overlapping(query));
+        }
+
+        wolv::container::RingBuffer<u32> ringBuffer(16, &arena);
+        ringBuffer.push(1337);
+        TEST_ASSERT(ringBuffer.front() == 1337);
+    }
+
+    // Everything allocated for the tree goes away at once
+    arena.reset();
+    TEST_ASSERT(arena.getBytesUsed() == 0);
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,113 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/lazy.hpp>
+#include <wolv/utils/thread_pool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+TEST_SEQUENCE("Lazy_Inplace") {
+    u32 calls = 0;
+    wolv::container::InplaceLazy lazy([&calls] {
+        calls += 1;
+        return std::string("value");
+    });
+
+    TEST_ASSERT(!lazy.isInitialized());
+    TEST_ASSERT(calls == 0);
+    TEST_ASSERT(lazy.get() == "value");
+    TEST_ASSERT(lazy->size() == 5);
+    TEST_ASSERT(lazy.isInitialized());
+    TEST_ASSERT(calls == 1);
+
+    // A throwing initializer leaves the value uninitialized so the next access tries again
+    u32 attempts = 0;
+    wolv::container::InplaceLazy<u32> failing([&attempts]() -> u32 {
+        attempts += 1;
+        if (attempts == 1)
+            throw std::runtime_error("failed");
+
+        return 42;
+    });
+
+    bool thrown = false;
+    try {
+        (void)failing.get();
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    TEST_ASSERT(thrown);
+    TEST_ASSERT(!failing.isInitialized());
+    TEST_ASSERT(*failing == 42);
+
+    // Concurrent accesses only run the initializer once
+    std::atomic<u32> concurrentCalls = 0;
+    const wolv::container::InplaceLazy shared([&concurrentCalls] {
+        concurrentCalls += 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return 1337;
+    });
+
+    std::vector<std::thread> threads;
+    std::atomic<u32> sum = 0;
+    for (u32 i = 0; i < 8; i++)
+        threads.emplace_back([&] { sum += shared.get(); });
+    for (auto &thread : threads)
+        thread.join();
+
+    TEST_ASSERT(concurrentCalls.load() == 1);
+    TEST_ASSERT(sum.load() == 8 * 1337);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Lazy_Async") {
+    wolv::util::ThreadPool pool(2);
+
+    std::vector<wolv::container::AsyncLazy<u64>> values;
+    for (u64 i = 0; i < 16; i++) {
+        values.emplace_back(pool, [i] {
+            u64 result = 0;
+            for (u64 j = 0; j <= i * 1000; j++)
+                result += j;
+
+            return result;
+        });
+    }
+
+    bool correct = true;
+    for (u64 i = 0; i < values.size(); i++)
+        correct = correct && values[i].get() == (i * 1000) * (i * 1000 + 1) / 2;
+    TEST_ASSERT(correct);
+
+    // Exceptions get stored and rethrown on every access
+    wolv::container::AsyncLazy<u32> failing(pool, []() -> u32 { throw std::runtime_error("failed"); });
+    u32 thrown = 0;
+    for (u32 i = 0; i < 2; i++) {
+        try {
+            (void)failing.get();
+        } catch (const std::runtime_error &) {
+            thrown += 1;
+        }
+    }
+    TEST_ASSERT(thrown == 2);
+
+    // Values not picked up by the pool yet get computed by the caller instead of waiting
+    std::atomic<bool> release = false;
+    pool.enqueue([&release](const std::atomic<bool> &) { release.wait(false); });
+    pool.enqueue([&release](const std::atomic<bool> &) { release.wait(false); });
+
+    wolv::container::AsyncLazy<u32> blocked(pool, [] { return 7; });
+    TEST_ASSERT(blocked.get() == 7);
+
+    release = true;
+    release.notify_all();
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,164 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/lru_cache.hpp>
+#include <wolv/utils/thread_pool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+TEST_SEQUENCE("LruCache_Basic") {
+    // A single shard makes the eviction order exact
+    wolv::container::LruCache<u32, std::string> cache(3, 1);
+
+    cache.insert(1, "one");
+    cache.insert(2, "two");
+    auto three = cache.insert(3, "three");
+    TEST_ASSERT(cache.size() == 3);
+
+    // Using 1 makes 2 the least recently used entry
+    TEST_ASSERT(*cache.get(1) == "one");
+    cache.insert(4, "four");
+    TEST_ASSERT(cache.size() == 3);
+    TEST_ASSERT(!cache.contains(2));
+    TEST_ASSERT(cache.contains(1));
+    TEST_ASSERT(cache.get(2) == nullptr);
+
+    // Values that are still in use survive their eviction
+    cache.insert(5, "five");
+    TEST_ASSERT(!cache.contains(3));
+    TEST_ASSERT(*three == "three");
+    cache.insert(6, "six");
+    TEST_ASSERT(!cache.contains(1));
+
+    TEST_ASSERT(cache.erase(6));
+    TEST_ASSERT(!cache.erase(6));
+    TEST_ASSERT(cache.size() == 2);
+
+    const auto statistics = cache.getStatistics();
+    TEST_ASSERT(statistics.hits == 1);
+    TEST_ASSERT(statistics.misses == 1);
+    TEST_ASSERT(statistics.evictions == 3);
+
+    cache.clear();
+    TEST_ASSERT(cache.size() == 0);
+
+    // Cost based eviction
+    struct StringCost {
+        size_t operator()(u32, const std::string &value) const { return value.size(); }
+    };
+
+    wolv::container::LruCache<u32, std::string, StringCost> sized(10, 1);
+    sized.insert(1, "aaaa");
+    sized.insert(2, "bbbb");
+    TEST_ASSERT(sized.getCost() == 8);
+    sized.insert(3, "cccc");
+    TEST_ASSERT(sized.getCost() == 8);
+    TEST_ASSERT(!sized.contains(1));
+
+    // Replacing a value updates the cost
+    sized.insert(3, "cc");
+    TEST_ASSERT(sized.getCost() == 6);
+    // Entries more expensive than the whole budget push out everything else, but stay cached themselves
+    sized.insert(4, std::string(20, 'd'));
+    TEST_ASSERT(sized.size() == 1);
+    TEST_ASSERT(sized.contains(4));
+    TEST_ASSERT(sized.getCost() == 20);
+
+    // Failed computations aren't cached
+    bool thrown = false;
+    try {
+        (void)cache.getOrCompute(7, []() -> std::string { throw std::runtime_error("failed"); });
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    TEST_ASSERT(thrown);
+    TEST_ASSERT(!cache.contains(7));
+    TEST_ASSERT(*cache.getOrCompute(7, [](u32 key) { return std::to_string(key); }) == "7");
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("LruCache_Shards") {
+    // The budget is shared by all shards, even if it's smaller than the number of shards
+    wolv::container::LruCache<u32, u32> small(3);
+    for (u32 i = 0; i < 100; i += 1) {
+        small.insert(i, i);
+        TEST_ASSERT(small.contains(i));
+    }
+
+    TEST_ASSERT(small.size() == 3);
+    TEST_ASSERT(small.getCost() == 3);
+    TEST_ASSERT(small.getStatistics().evictions == 97);
+
+    // Entries costing more than an even part of the budget per shard don't evict themselves
+    struct StringCost {
+        size_t operator()(u32, const std::string &value) const { return value.size(); }
+    };
+
+    wolv::container::LruCache<u32, std::string, StringCost> sized(64);
+    for (u32 i = 0; i < 100; i += 1) {
+        sized.insert(i, std::string(20, 'a'));
+        TEST_ASSERT(sized.contains(i));
+        TEST_ASSERT(sized.getCost() <= 64);
+    }
+
+    TEST_ASSERT(sized.size() == 3);
+
+    sized.insert(100, std::string(100, 'b'));
+    TEST_ASSERT(sized.contains(100));
+    TEST_ASSERT(sized.size() == 1);
+
+    TEST_ASSERT(*sized.getOrCompute(101, [] { return std::string(10, 'c'); }) == std::string(10, 'c'));
+    TEST_ASSERT(sized.contains(101));
+    TEST_ASSERT(sized.size() == 1);
+    TEST_ASSERT(sized.getCost() == 10);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("LruCache_Concurrent") {
+    constexpr static u32 Keys = 64;
+
+    // There's room for all keys, so nothing gets evicted
+    wolv::container::LruCache<u32, u64> cache(Keys);
+
+    std::vector<std::atomic<u32>> computations(Keys);
+    std::atomic<u32> wrongValues = 0;
+
+    {
+        wolv::util::ThreadPool threadPool(8);
+
+        for (u32 i = 0; i < 2000; i += 1) {
+            threadPool.enqueue([&, i](const auto &) {
+                const auto key = (i * 7) % Keys;
+                const auto value = cache.getOrCompute(key, [&](u32 key) {
+                    computations[key] += 1;
+                    return u64(key) * key;
+                });
+
+                if (*value != u64(key) * key)
+                    wrongValues += 1;
+            });
+        }
+
+        threadPool.stop();
+    }
+
+    TEST_ASSERT(wrongValues.load() == 0);
+
+    // Concurrent misses of a key have been merged into a single computation
+    for (const auto &count : computations)
+        TEST_ASSERT(count.load() == 1);
+
+    const auto statistics = cache.getStatistics();
+    TEST_ASSERT(statistics.evictions == 0);
+    TEST_ASSERT(statistics.misses == Keys);
+    TEST_ASSERT(statistics.hits + statistics.misses + statistics.coalescedMisses == 2000);
+    TEST_ASSERT(cache.size() == Keys);
+
+    TEST_SUCCESS();
+};
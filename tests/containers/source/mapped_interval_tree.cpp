@@ -0,0 +1,144 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/interval_tree.hpp>
+#include <wolv/container/mapped_interval_tree.hpp>
+#include <wolv/io/file.hpp>
+#include <wolv/utils/guards.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+namespace {
+
+    struct Annotation {
+        u32 color;
+        u16 flags;
+    };
+
+    using Tree = wolv::container::IntervalTree<Annotation>;
+    using MappedTree = wolv::container::MappedIntervalTree<Annotation>;
+    using MappedTree32 = wolv::container::MappedIntervalTree<Annotation, u32>;
+
+    std::vector<u32> colors(const auto &data) {
+        std::vector<u32> result;
+        for (const auto &item : data)
+            result.push_back(item.value.color);
+
+        std::ranges::sort(result);
+        return result;
+    }
+
+    // Copies a buffer into memory with the alignment a memory mapping would have
+    std::unique_ptr<u8[], void(*)(u8*)> alignedCopy(const std::vector<u8> &data) {
+        auto buffer = static_cast<u8*>(::operator new[](data.size() + 1, std::align_val_t(64)));
+        std::memcpy(buffer, data.data(), data.size());
+
+        return { buffer, [](u8 *pointer) { ::operator delete[](pointer, std::align_val_t(64)); } };
+    }
+
+}
+
+TEST_SEQUENCE("MappedIntervalTree") {
+    std::mt19937 generator(1234);
+
+    Tree tree;
+    for (u32 i = 0; i < 5000; i++) {
+        const auto start = std::uniform_int_distribution<u64>(0, 100000)(generator);
+        const auto size  = std::uniform_int_distribution<u64>(0, 200)(generator);
+        const auto handle = tree.insert({ start, start + size }, { i, u16(i % 7) });
+
+        if (i % 10 == 0)
+            tree.erase(handle);
+    }
+
+    const auto filePath = std::fs::current_path() / "mapped_interval_tree.bin";
+    ON_SCOPE_EXIT { std::fs::remove(filePath); };
+
+    {
+        wolv::io::File file(filePath, wolv::io::File::Mode::Create);
+        TEST_ASSERT(file.isValid());
+        file.writeVector(MappedTree::serialize(tree));
+    }
+
+    wolv::io::File file(filePath, wolv::io::File::Mode::Read);
+    TEST_ASSERT(file.isValid());
+    TEST_ASSERT(file.map());
+
+    const auto mapped = MappedTree::load(file);
+    TEST_ASSERT(mapped.has_value());
+    TEST_ASSERT(mapped->size() == tree.size());
+
+    for (u32 i = 0; i < 500; i++) {
+        const auto start = std::uniform_int_distribution<u64>(0, 100000)(generator);
+        const Tree::Interval query = { start, start + 500 };
+
+        const auto expected = tree.overlapping(query);
+        const auto result = mapped->overlapping(query);
+        TEST_ASSERT(colors(result) == colors(expected));
+        TEST_ASSERT(result.size() == expected.size());
+        TEST_ASSERT(std::ranges::equal(result, expected, [](const auto &left, const auto &right) {
+            return left.interval.start == right.interval.start && left.interval.end == right.interval.end;
+        }));
+
+        TEST_ASSERT(mapped->anyOverlapping(query) == !expected.empty());
+        TEST_ASSERT(!mapped->firstOverlapping(query) || mapped->firstOverlapping(query)->interval.start == tree.firstOverlapping(query)->interval.start);
+
+        const auto next = mapped->nextInterval(start);
+        const auto prev = mapped->prevInterval(start);
+        TEST_ASSERT(next.has_value() == tree.nextInterval(start).has_value());
+        TEST_ASSERT(prev.has_value() == tree.prevInterval(start).has_value());
+        TEST_ASSERT(!next || next->interval.start == tree.nextInterval(start)->interval.start);
+        TEST_ASSERT(!prev || prev->interval.start == tree.prevInterval(start)->interval.start);
+
+        for (const auto &item : result) {
+            const auto expectedFlags = item.value.color % 7;
+            TEST_ASSERT(item.value.flags == expectedFlags);
+        }
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("MappedIntervalTree_Validation") {
+    Tree tree = {
+        { { 0, 5 }, { 1, 0 } },
+        { { 3, 9 }, { 2, 0 } },
+    };
+
+    const auto serialized = MappedTree::serialize(tree);
+    const auto buffer = alignedCopy(serialized);
+    const std::span<const u8> data = { buffer.get(), serialized.size() };
+
+    TEST_ASSERT(MappedTree::load(data).has_value());
+    TEST_ASSERT(MappedTree::load(data)->firstOverlapping({ 4, 4 })->value.color == 1);
+
+    // Truncated, misaligned or mismatching buffers are rejected
+    TEST_ASSERT(!MappedTree::load(data.first(data.size() - 1)).has_value());
+    TEST_ASSERT(!MappedTree::load(data.first(16)).has_value());
+    TEST_ASSERT(!wolv::container::MappedIntervalTree<u64>::load(data).has_value());
+    TEST_ASSERT(!MappedTree32::load(data).has_value());
+
+    const auto misaligned = alignedCopy(std::vector<u8>(serialized.size() + 1));
+    std::memcpy(misaligned.get() + 1, serialized.data(), serialized.size());
+    TEST_ASSERT(!MappedTree::load(std::span<const u8>(misaligned.get() + 1, serialized.size())).has_value());
+
+    for (size_t offset = 0; offset < 8 + 4; offset++) {
+        const auto corrupted = alignedCopy(serialized);
+        corrupted[offset] ^= 0xFF;
+        TEST_ASSERT(!MappedTree::load(std::span<const u8>(corrupted.get(), serialized.size())).has_value());
+    }
+
+    // Empty trees round trip as well
+    const auto empty = MappedTree::serialize(Tree());
+    const auto emptyBuffer = alignedCopy(empty);
+    const auto emptyTree = MappedTree::load({ emptyBuffer.get(), empty.size() });
+    TEST_ASSERT(emptyTree.has_value() && emptyTree->empty());
+    TEST_ASSERT(!emptyTree->anyOverlapping({ 0, 100 }));
+
+    TEST_SUCCESS();
+};
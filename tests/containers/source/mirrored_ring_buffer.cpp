@@ -0,0 +1,52 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/mirrored_ring_buffer.hpp>
+
+#include <numeric>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+TEST_SEQUENCE("MirroredRingBuffer") {
+    wolv::container::MirroredRingBuffer buffer(100);
+    TEST_ASSERT(buffer.capacity() >= 100);
+    TEST_ASSERT(std::has_single_bit(buffer.capacity()));
+
+    const auto capacity = buffer.capacity();
+    std::vector<u8> data(capacity);
+    std::iota(data.begin(), data.end(), 0);
+
+    TEST_ASSERT(buffer.pushSpan(data) == capacity);
+    TEST_ASSERT(buffer.full());
+
+    // Move the read and write positions close to the end of the storage
+    buffer.consume(capacity - 10);
+    TEST_ASSERT(buffer.pushSpan(std::span(data).first(20)) == 20);
+
+    // The stored bytes wrap around the end of the storage but are still readable as one contiguous span
+    const auto readable = buffer.readable();
+    TEST_ASSERT(readable.size() == 30);
+    for (size_t i = 0; i < 10; i++)
+        TEST_ASSERT(readable[i] == data[capacity - 10 + i]);
+    for (size_t i = 0; i < 20; i++)
+        TEST_ASSERT(readable[10 + i] == data[i]);
+
+    // Writing past the end of the first mapping shows up at the start of the buffer
+    auto writable = buffer.writable();
+    TEST_ASSERT(writable.size() == capacity - 30);
+    writable[0] = 0xAA;
+    buffer.commitWrite(1);
+    TEST_ASSERT(buffer.readable().back() == 0xAA);
+
+    std::vector<u8> out(64);
+    TEST_ASSERT(buffer.popSpan(out) == 31);
+    TEST_ASSERT(out[30] == 0xAA);
+    TEST_ASSERT(buffer.empty());
+
+    // Ownership of the mapping moves along with the buffer
+    auto moved = std::move(buffer);
+    TEST_ASSERT(moved.capacity() == capacity);
+    TEST_ASSERT(moved.pushSpan(data) == capacity);
+
+    TEST_SUCCESS();
+};
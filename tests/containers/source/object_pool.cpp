@@ -0,0 +1,123 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/object_pool.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+using namespace wolv::container;
+
+namespace {
+
+    struct Object {
+        explicit Object(u64 value) : value(value), text(std::to_string(value)) { }
+
+        u64 value;
+        std::string text;
+    };
+
+}
+
+TEST_SEQUENCE("ObjectPool_Basic") {
+    // Freed objects are handed out again on the same thread
+    auto first = ObjectPool<Object>::create(1);
+    TEST_ASSERT(first->text == "1");
+    ObjectPool<Object>::destroy(first);
+    auto second = ObjectPool<Object>::create(2);
+    TEST_ASSERT(second == first);
+    ObjectPool<Object>::destroy(second);
+
+    {
+        std::vector<ObjectPool<Object>::Pointer> objects;
+        for (u64 i = 0; i < 1000; i += 1)
+            objects.push_back(ObjectPool<Object>::make(i));
+
+        for (u64 i = 0; i < objects.size(); i += 1) {
+            TEST_ASSERT(objects[i]->value == i);
+            const auto misalignment = reinterpret_cast<std::uintptr_t>(objects[i].get()) % alignof(Object);
+            TEST_ASSERT(misalignment == 0);
+        }
+    }
+
+    // Node based containers and large allocations
+    {
+        std::list<u64, SlabAllocator<u64>> list;
+        std::deque<std::string, SlabAllocator<std::string>> deque;
+        std::vector<u8, SlabAllocator<u8>> large(0x10000, 0xAA);
+
+        for (u64 i = 0; i < 1000; i += 1) {
+            list.push_back(i);
+            deque.push_back(std::to_string(i));
+        }
+
+        TEST_ASSERT(list.back() == 999);
+        TEST_ASSERT(deque[500] == "500");
+        TEST_ASSERT(large.back() == 0xAA);
+    }
+
+    {
+        std::pmr::vector<u64> vector(getSlabResource());
+        for (u64 i = 0; i < 100; i += 1)
+            vector.push_back(i);
+        TEST_ASSERT(vector[99] == 99);
+        TEST_ASSERT(getSlabResource()->is_equal(*getSlabResource()));
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("ObjectPool_Threads") {
+    constexpr static u32 ThreadCount = 4;
+    constexpr static u32 ObjectsPerThread = 5000;
+
+    std::atomic<u32> wrongValues = 0;
+
+    // Objects are created on one thread and destroyed on another one, then all threads exit and return their caches
+    const auto round = [&] {
+        std::vector<std::vector<Object*>> objects(ThreadCount);
+
+        std::vector<std::thread> producers;
+        for (u32 thread = 0; thread < ThreadCount; thread += 1) {
+            producers.emplace_back([&, thread] {
+                for (u32 i = 0; i < ObjectsPerThread; i += 1)
+                    objects[thread].push_back(ObjectPool<Object>::create(u64(thread) << 32 | i));
+            });
+        }
+        for (auto &thread : producers)
+            thread.join();
+
+        std::vector<std::thread> consumers;
+        for (u32 thread = 0; thread < ThreadCount; thread += 1) {
+            consumers.emplace_back([&, thread] {
+                const auto &list = objects[(thread + 1) % ThreadCount];
+                for (u32 i = 0; i < list.size(); i += 1) {
+                    if (list[i]->value != (u64((thread + 1) % ThreadCount) << 32 | i))
+                        wrongValues += 1;
+
+                    ObjectPool<Object>::destroy(list[i]);
+                }
+            });
+        }
+        for (auto &thread : consumers)
+            thread.join();
+    };
+
+    round();
+    const auto reserved = SlabResource::getBytesReserved();
+
+    // Memory returned by exited threads gets reused instead of growing the pools
+    for (u32 i = 0; i < 3; i += 1)
+        round();
+
+    TEST_ASSERT(wrongValues.load() == 0);
+    TEST_ASSERT(SlabResource::getBytesReserved() == reserved);
+
+    TEST_SUCCESS();
+};
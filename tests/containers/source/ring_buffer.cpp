@@ -0,0 +1,85 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/ring_buffer.hpp>
+#include <wolv/types.hpp>
+
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+TEST_SEQUENCE("RingBuffer_Basic") {
+    wolv::container::RingBuffer<u32> buffer(3);
+    TEST_ASSERT(buffer.capacity() == 3);
+
+    for (u32 i = 0; i < 5; i++)
+        buffer.push(i);
+
+    // Pushing into a full buffer overwrites the oldest elements
+    TEST_ASSERT(buffer.full());
+    TEST_ASSERT(buffer.front() == 2);
+    TEST_ASSERT(buffer.back() == 4);
+    TEST_ASSERT(std::vector<u32>(buffer.begin(), buffer.end()) == std::vector<u32>({ 2, 3, 4 }));
+
+    u32 value = 0;
+    TEST_ASSERT(buffer.pop(value) && value == 2);
+    TEST_ASSERT(buffer.pop(value) && value == 3);
+    TEST_ASSERT(buffer.pop(value) && value == 4);
+    TEST_ASSERT(!buffer.pop(value));
+    TEST_ASSERT(buffer.empty());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("RingBuffer_Span") {
+    wolv::container::RingBuffer<u8> buffer(6);
+
+    std::array<u8, 10> data = { };
+    std::iota(data.begin(), data.end(), 0);
+
+    // Only as much as there's free space for is pushed, nothing gets overwritten
+    TEST_ASSERT(buffer.pushSpan(data) == 6);
+    TEST_ASSERT(buffer.full());
+    TEST_ASSERT(buffer.pushSpan(data) == 0);
+
+    using Bytes = std::array<u8, 4>;
+    Bytes out = { };
+    TEST_ASSERT(buffer.popSpan(out) == 4);
+    TEST_ASSERT(out == Bytes({ 0, 1, 2, 3 }));
+
+    // Pushing again wraps around the end of the storage
+    TEST_ASSERT(buffer.pushSpan(std::span(data).subspan(6)) == 4);
+
+    const auto readable = std::as_const(buffer).readableRegions();
+    TEST_ASSERT(readable[0].size() + readable[1].size() == 6);
+    TEST_ASSERT(!readable[1].empty());
+
+    std::array<u8, 10> all = { };
+    TEST_ASSERT(buffer.popSpan(all) == 6);
+    TEST_ASSERT(std::memcmp(all.data(), data.data() + 4, 6) == 0);
+    TEST_ASSERT(buffer.empty());
+
+    // Data can be written straight into the free space and read straight out of the stored elements
+    auto writable = buffer.writableRegions();
+    TEST_ASSERT(writable[0].size() + writable[1].size() == 6);
+    writable[0][0] = 42;
+    buffer.commitWrite(1);
+    TEST_ASSERT(buffer.size() == 1 && buffer.front() == 42);
+
+    buffer.consume(1);
+    TEST_ASSERT(buffer.empty());
+
+    // Non-trivial element types are moved element by element
+    wolv::container::RingBuffer<std::string> strings(2);
+    const std::array<std::string, 3> input = { "a", "b", "c" };
+    TEST_ASSERT(strings.pushSpan(input) == 2);
+
+    std::array<std::string, 3> output;
+    TEST_ASSERT(strings.popSpan(output) == 2);
+    TEST_ASSERT(output[0] == "a" && output[1] == "b" && output[2].empty());
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,212 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/roaring_bitmap.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+namespace {
+
+    using Bitmap = wolv::container::RoaringBitmap;
+    using Range  = std::pair<u64, u64>;
+
+    std::vector<u64> values(const Bitmap &bitmap) {
+        std::vector<u64> result;
+        bitmap.forEach([&result](u64 value) { result.push_back(value); });
+
+        return result;
+    }
+
+    std::vector<u64> values(const std::set<u64> &set) {
+        return { set.begin(), set.end() };
+    }
+
+    // Builds a random set mixing sparse values, dense regions and long ranges over a few chunks
+    std::pair<Bitmap, std::set<u64>> randomSet(std::mt19937_64 &random) {
+        Bitmap bitmap;
+        std::set<u64> reference;
+
+        for (u32 i = 0; i < 20; i++) {
+            const u64 base = (random() % 6) << 16;
+
+            switch (random() % 3) {
+                case 0:
+                    for (u32 j = 0; j < 200; j++) {
+                        const auto value = base + random() % 0x10000;
+                        bitmap.add(value);
+                        reference.insert(value);
+                    }
+                    break;
+                case 1:
+                    for (u32 j = 0; j < 6000; j++) {
+                        const auto value = base + random() % 0x4000;
+                        bitmap.add(value);
+                        reference.insert(value);
+                    }
+                    break;
+                case 2: {
+                    const auto start = base + random() % 0x18000;
+                    const auto end = start + random() % 0x1000;
+                    bitmap.addRange(start, end);
+                    for (auto value = start; value <= end; value++)
+                        reference.insert(value);
+                    break;
+                }
+            }
+        }
+
+        return { std::move(bitmap), std::move(reference) };
+    }
+
+}
+
+TEST_SEQUENCE("RoaringBitmap_Basic") {
+    Bitmap bitmap = { 1, 5, 0x12345678, 0xFFFF'FFFF'FFFF'FFFF };
+
+    TEST_ASSERT(bitmap.cardinality() == 4);
+    TEST_ASSERT(bitmap.contains(5));
+    TEST_ASSERT(!bitmap.contains(6));
+    TEST_ASSERT(bitmap.contains(0xFFFF'FFFF'FFFF'FFFF));
+
+    TEST_ASSERT(!bitmap.add(5));
+    TEST_ASSERT(bitmap.remove(5));
+    TEST_ASSERT(!bitmap.remove(5));
+    TEST_ASSERT(bitmap.cardinality() == 3);
+
+    TEST_ASSERT(bitmap.rank(0) == 0);
+    TEST_ASSERT(bitmap.rank(1) == 1);
+    TEST_ASSERT(bitmap.rank(0x12345678) == 2);
+    TEST_ASSERT(bitmap.select(0) == 1);
+    TEST_ASSERT(bitmap.select(2) == 0xFFFF'FFFF'FFFF'FFFF);
+    TEST_ASSERT(!bitmap.select(3).has_value());
+
+    // Ranges crossing chunk boundaries are reported as one
+    bitmap.clear();
+    bitmap.addRange(0xFFF0, 0x2000F);
+    bitmap.add(0x30000);
+    bitmap.removeRange(0x18000, 0x18000);
+
+    std::vector<Range> ranges;
+    bitmap.forEachRange([&ranges](u64 start, u64 end) { ranges.emplace_back(start, end); });
+    TEST_ASSERT(ranges == std::vector<Range>({ { 0xFFF0, 0x17FFF }, { 0x18001, 0x2000F }, { 0x30000, 0x30000 } }));
+    TEST_ASSERT(bitmap.cardinality() == 0x2000F - 0xFFF0 + 1);
+    TEST_ASSERT(bitmap.rank(0x18001) == 0x18000 - 0xFFF0 + 1);
+    TEST_ASSERT(bitmap.select(0x18000 - 0xFFF0) == 0x18001);
+
+    // Ranges merge into existing chunks of any kind and only touch the chunks they overlap
+    {
+        constexpr static u64 Max = 0xFFFF'FFFF'FFFF'FFFF;
+
+        Bitmap merged = { 5, 7, 0x10005, Max - 1 };
+        for (u64 value = 0x20000; value < 0x28000; value += 2)
+            merged.add(value);
+
+        merged.addRange(6, 0x20010);
+        TEST_ASSERT(merged.cardinality() == 1 + (0x20010 - 6 + 1) + (0x8000 / 2 - 9) + 1);
+        TEST_ASSERT(merged.contains(5) && merged.contains(0x1FFFF) && !merged.contains(0x20011) && merged.contains(0x20012));
+
+        merged.addRange(Max - 0x20000, Max);
+        TEST_ASSERT(merged.contains(Max) && merged.contains(Max - 0x20000) && !merged.contains(Max - 0x20001));
+
+        // Removing up to the end of the value range only visits the chunks that exist
+        merged.removeRange(0x20011, Max);
+        std::vector<Range> mergedRanges;
+        merged.forEachRange([&mergedRanges](u64 start, u64 end) { mergedRanges.emplace_back(start, end); });
+        TEST_ASSERT(mergedRanges == std::vector<Range>({ { 5, 0x20010 } }));
+
+        merged.removeRange(0x8000, 0x18000);
+        TEST_ASSERT(merged.cardinality() == (0x8000 - 5) + (0x20010 - 0x18001 + 1));
+
+        merged.removeRange(0, Max);
+        TEST_ASSERT(merged.empty());
+    }
+
+    // Adding consecutive values one by one and optimizing ends up with the same set in less memory
+    Bitmap single;
+    for (u64 value = 0xFFF0; value <= 0x2000F; value++)
+        single.add(value);
+    single.add(0x30000);
+    single.remove(0x18000);
+
+    const auto before = single.getMemoryUsage();
+    single.optimize();
+    TEST_ASSERT(single.getMemoryUsage() < before);
+    TEST_ASSERT(single == bitmap);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("RoaringBitmap_SetOperations") {
+    std::mt19937_64 random(1234);
+
+    for (u32 round = 0; round < 5; round++) {
+        const auto [left, leftReference] = randomSet(random);
+        const auto [right, rightReference] = randomSet(random);
+
+        TEST_ASSERT(values(left) == values(leftReference));
+        TEST_ASSERT(left.cardinality() == leftReference.size());
+
+        std::set<u64> expected;
+        std::set_union(leftReference.begin(), leftReference.end(), rightReference.begin(), rightReference.end(), std::inserter(expected, expected.end()));
+        TEST_ASSERT(values(left | right) == values(expected));
+
+        expected.clear();
+        std::set_intersection(leftReference.begin(), leftReference.end(), rightReference.begin(), rightReference.end(), std::inserter(expected, expected.end()));
+        TEST_ASSERT(values(left & right) == values(expected));
+        TEST_ASSERT((left & right).cardinality() == expected.size());
+
+        expected.clear();
+        std::set_difference(leftReference.begin(), leftReference.end(), rightReference.begin(), rightReference.end(), std::inserter(expected, expected.end()));
+        TEST_ASSERT(values(left - right) == values(expected));
+
+        // Rank and select agree with the sorted values
+        const auto sorted = values(leftReference);
+        for (u32 i = 0; i < 100; i++) {
+            const auto index = random() % sorted.size();
+            TEST_ASSERT(left.select(index) == sorted[index]);
+            TEST_ASSERT(left.rank(sorted[index]) == index + 1);
+        }
+
+        auto optimized = left;
+        optimized.optimize();
+        TEST_ASSERT(optimized == left);
+        TEST_ASSERT(values(optimized) == sorted);
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("RoaringBitmap_Large") {
+    constexpr u64 BitCount = 1'000'000'000;
+
+    Bitmap bitmap;
+    bitmap.addRange(0, BitCount - 1);
+    TEST_ASSERT(bitmap.cardinality() == BitCount);
+
+    // Punch a hole into every chunk, which turns them into two runs each
+    for (u64 value = 0x8000; value < BitCount; value += 0x10000)
+        bitmap.remove(value);
+
+    const auto holes = (BitCount - 0x8000 + 0xFFFF) / 0x10000;
+    TEST_ASSERT(bitmap.cardinality() == BitCount - holes);
+    TEST_ASSERT(bitmap.getMemoryUsage() < 4 * 1024 * 1024);
+
+    TEST_ASSERT(bitmap.rank(BitCount - 1) == BitCount - holes);
+    TEST_ASSERT(bitmap.select(0x8000) == 0x8001);
+
+    Bitmap even;
+    for (u64 value = 0; value < 0x100000; value += 2)
+        even.add(value);
+
+    const auto intersection = bitmap & even;
+    TEST_ASSERT(intersection.cardinality() == 0x80000 - 0x10);
+    TEST_ASSERT((bitmap - even).cardinality() == BitCount - holes - intersection.cardinality());
+
+    TEST_SUCCESS();
+};
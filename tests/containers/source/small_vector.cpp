@@ -0,0 +1,61 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/container/small_vector.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+TEST_SEQUENCE("SmallVector") {
+    using Vector = wolv::container::SmallVector<std::string, 4>;
+
+    Vector vector;
+    TEST_ASSERT(vector.empty());
+    TEST_ASSERT(vector.capacity() == 4);
+
+    for (u32 i = 0; i < 4; i++)
+        vector.push_back(std::to_string(i));
+    TEST_ASSERT(vector.isInline());
+
+    // Growing past the inline capacity moves everything to the heap, even if the new element refers to an old one
+    vector.push_back(vector[0]);
+    TEST_ASSERT(!vector.isInline());
+    TEST_ASSERT(vector.size() == 5);
+    TEST_ASSERT(vector.back() == "0");
+
+    vector.insert(vector.begin() + 1, "a");
+    vector.erase(vector.begin() + 3);
+    TEST_ASSERT(vector == Vector({ "0", "a", "1", "3", "0" }));
+
+    vector.erase(vector.begin(), vector.begin() + 2);
+    vector.pop_back();
+    TEST_ASSERT(vector == Vector({ "1", "3" }));
+
+    // Copies and moves of inline and heap vectors keep their contents
+    Vector small = { "x", "y" };
+    Vector moved = std::move(small);
+    TEST_ASSERT(moved.isInline());
+    TEST_ASSERT(moved == Vector({ "x", "y" }));
+    TEST_ASSERT(small.empty());
+
+    Vector large(10, "z");
+    Vector copy = large;
+    Vector stolen = std::move(large);
+    TEST_ASSERT(!stolen.isInline());
+    TEST_ASSERT(copy == stolen);
+    TEST_ASSERT(large.empty());
+    TEST_ASSERT(large.isInline());
+
+    stolen.resize(2);
+    TEST_ASSERT(stolen == Vector({ "z", "z" }));
+
+    moved = stolen;
+    TEST_ASSERT(moved == stolen);
+
+    std::vector<u32> source = { 1, 2, 3 };
+    wolv::container::SmallVector<u32, 2> numbers(source.begin(), source.end());
+    TEST_ASSERT(std::vector<u32>(numbers.begin(), numbers.end()) == source);
+
+    TEST_SUCCESS();
+};
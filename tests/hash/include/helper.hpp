@@ -0,0 +1,10 @@
+#pragma once
+
+#include <wolv/types.hpp>
+
+#include <span>
+#include <string>
+#include <vector>
+
+std::vector<wolv::u8> randomBytes(size_t size, unsigned seed);
+std::string toHex(std::span<const wolv::u8> bytes);
@@ -0,0 +1,139 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/hash/checksum.hpp>
+
+#include <helper.hpp>
+
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    std::span<const wolv::u8> toBytes(std::string_view string) {
+        return { reinterpret_cast<const wolv::u8*>(string.data()), string.size() };
+    }
+
+    template<typename Checksum>
+    auto checksum(std::span<const wolv::u8> data, auto && ... args) {
+        Checksum checksum(args...);
+        checksum.process(data);
+
+        return checksum.getResult();
+    }
+
+}
+
+TEST_SEQUENCE("Checksum_Adler32") {
+    using wolv::hash::Adler32;
+
+    TEST_ASSERT(checksum<Adler32>({ }) == 0x00000001);
+    TEST_ASSERT(checksum<Adler32>(toBytes("Wikipedia")) == 0x11E60398);
+
+    // All 0xFF bytes maximize the sums and make sure the modular reductions are correct
+    const std::vector<wolv::u8> ones(100000, 0xFF);
+    TEST_ASSERT(checksum<Adler32>(ones) == 0x149A302C);
+
+    const auto data = randomBytes(100000, 1);
+    const auto expected = checksum<Adler32>(data);
+
+    for (size_t split : { 0, 1, 31, 4096, 50001, 99999 }) {
+        Adler32 adler32;
+        adler32.process(std::span(data).first(split));
+        const auto first = adler32.getResult();
+        adler32.process(std::span(data).subspan(split));
+        TEST_ASSERT(adler32.getResult() == expected);
+
+        const auto second = checksum<Adler32>(std::span(data).subspan(split));
+        TEST_ASSERT(Adler32::combine(first, second, data.size() - split) == expected);
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Checksum_Fletcher") {
+    using wolv::hash::Fletcher16;
+    using wolv::hash::Fletcher32;
+
+    TEST_ASSERT(checksum<Fletcher16>(toBytes("abcde")) == 0xC8F0);
+    TEST_ASSERT(checksum<Fletcher16>(toBytes("abcdef")) == 0x2057);
+    TEST_ASSERT(checksum<Fletcher32>(toBytes("abcde")) == 0xF04FC729);
+    TEST_ASSERT(checksum<Fletcher32>(toBytes("abcdef")) == 0x56502D2A);
+    TEST_ASSERT(checksum<Fletcher32>(toBytes("abcdefgh")) == 0xEBE19591);
+
+    const auto data = randomBytes(300001, 2);
+    const auto expected16 = checksum<Fletcher16>(data);
+    const auto expected32 = checksum<Fletcher32>(data);
+
+    for (size_t split : { 0, 2, 64, 4096, 150000 }) {
+        const auto first16  = checksum<Fletcher16>(std::span(data).first(split));
+        const auto second16 = checksum<Fletcher16>(std::span(data).subspan(split));
+        TEST_ASSERT(Fletcher16::combine(first16, second16, data.size() - split) == expected16);
+
+        const auto first32  = checksum<Fletcher32>(std::span(data).first(split));
+        const auto second32 = checksum<Fletcher32>(std::span(data).subspan(split));
+        TEST_ASSERT(Fletcher32::combine(first32, second32, data.size() - split) == expected32);
+    }
+
+    // Odd sized chunks need to be stitched back together into 16 bit words
+    Fletcher32 fletcher32;
+    for (size_t offset = 0; offset < data.size(); offset += 333)
+        fletcher32.process(std::span(data).subspan(offset, std::min<size_t>(333, data.size() - offset)));
+    TEST_ASSERT(fletcher32.getResult() == expected32);
+
+    TEST_ASSERT(checksum<Fletcher32>(toBytes("badc"), std::endian::big) == checksum<Fletcher32>(toBytes("abcd")));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Checksum_SumXor") {
+    const auto data = randomBytes(12345, 3);
+
+    wolv::u64 sum = 0;
+    wolv::u8 xorValue = 0;
+    for (auto byte : data) {
+        sum += byte;
+        xorValue ^= byte;
+    }
+
+    TEST_ASSERT(checksum<wolv::hash::AdditiveChecksum<8>>(data) == (sum & 0xFF));
+    TEST_ASSERT(checksum<wolv::hash::AdditiveChecksum<16>>(data) == (sum & 0xFFFF));
+    TEST_ASSERT(checksum<wolv::hash::AdditiveChecksum<64>>(data) == sum);
+    TEST_ASSERT(checksum<wolv::hash::XorChecksum>(data) == xorValue);
+
+    const auto first = checksum<wolv::hash::AdditiveChecksum<16>>(std::span(data).first(100));
+    const auto second = checksum<wolv::hash::AdditiveChecksum<16>>(std::span(data).subspan(100));
+    TEST_ASSERT(wolv::hash::AdditiveChecksum<16>::combine(first, second) == (sum & 0xFFFF));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Checksum_Kernels") {
+    #if defined(WOLV_HASH_ARCH_X86)
+        using namespace wolv::hash::detail;
+
+        const auto &features = getCpuFeatures();
+        const auto data = randomBytes(MaxByteSumsSize, 4);
+
+        for (size_t size : { size_t(0), size_t(1), size_t(15), size_t(16), size_t(33), size_t(1000), MaxByteSumsSize }) {
+            const auto expected = byteSumsScalar(data.data(), size);
+            const auto expectedSum = byteSumScalar(data.data(), size);
+            const auto expectedXor = byteXorScalar(data.data(), size);
+
+            if (features.ssse3) {
+                const auto sums = byteSumsSsse3(data.data(), size);
+                TEST_ASSERT(sums.sum == expected.sum && sums.weightedSum == expected.weightedSum);
+                TEST_ASSERT(byteSumSsse3(data.data(), size) == expectedSum);
+                TEST_ASSERT(byteXorSsse3(data.data(), size) == expectedXor);
+            }
+
+            if (features.avx2) {
+                const auto sums = byteSumsAvx2(data.data(), size);
+                TEST_ASSERT(sums.sum == expected.sum && sums.weightedSum == expected.weightedSum);
+                TEST_ASSERT(byteSumAvx2(data.data(), size) == expectedSum);
+                TEST_ASSERT(byteXorAvx2(data.data(), size) == expectedXor);
+            }
+        }
+    #endif
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,100 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/hash/chunker.hpp>
+
+#include <helper.hpp>
+
+#include <cstring>
+#include <set>
+#include <vector>
+
+namespace {
+
+    using Chunker = wolv::hash::ContentDefinedChunker<>;
+
+    std::vector<Chunker::Chunk> chunkData(std::span<const wolv::u8> data, size_t feedSize) {
+        std::vector<Chunker::Chunk> chunks;
+        Chunker chunker([&chunks](const auto &chunk) { chunks.push_back(chunk); });
+
+        for (size_t offset = 0; offset < data.size(); offset += feedSize)
+            chunker.process(data.subspan(offset, std::min(feedSize, data.size() - offset)));
+        chunker.finish();
+
+        return chunks;
+    }
+
+    struct MemorySource {
+        std::span<const wolv::u8> data;
+
+        wolv::i64 readBufferAtomic(wolv::u64 address, wolv::u8 *buffer, size_t size) {
+            std::memcpy(buffer, data.data() + address, size);
+            return wolv::i64(size);
+        }
+    };
+
+}
+
+TEST_SEQUENCE("Chunker") {
+    const auto data = randomBytes(1024 * 1024, 1337);
+    const auto chunks = chunkData(data, data.size());
+
+    TEST_ASSERT(chunks.size() > 1);
+
+    // Chunks need to be contiguous, respect the size limits and carry the digest of their content
+    wolv::u64 offset = 0;
+    for (const auto &chunk : chunks) {
+        TEST_ASSERT(chunk.offset == offset);
+        TEST_ASSERT(chunk.size <= 64 * 1024);
+        if (&chunk != &chunks.back())
+            TEST_ASSERT(chunk.size >= 2 * 1024);
+
+        wolv::hash::Sha256 sha256;
+        sha256.process(std::span(data).subspan(chunk.offset, chunk.size));
+        TEST_ASSERT(sha256.getResult() == chunk.digest);
+
+        offset += chunk.size;
+    }
+    TEST_ASSERT(offset == data.size());
+
+    // Boundaries must not depend on how the stream was fed into the chunker
+    for (size_t feedSize : { 1, 4095, 65536 }) {
+        const auto fedChunks = chunkData(data, feedSize);
+        TEST_ASSERT(fedChunks.size() == chunks.size());
+
+        for (size_t i = 0; i < chunks.size(); i++)
+            TEST_ASSERT(fedChunks[i].offset == chunks[i].offset && fedChunks[i].digest == chunks[i].digest);
+    }
+
+    // Reading from a source has to give the same results as well
+    std::vector<Chunker::Chunk> sourceChunks;
+    Chunker chunker([&sourceChunks](const auto &chunk) { sourceChunks.push_back(chunk); });
+    MemorySource source = { data };
+    chunker.process(source, 0, data.size(), 10000);
+    chunker.finish();
+    TEST_ASSERT(sourceChunks.size() == chunks.size());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Chunker_Dedup") {
+    const auto data = randomBytes(1024 * 1024, 42);
+
+    // Inserting a few bytes at the start should only change the first chunk(s)
+    auto modified = data;
+    modified.insert(modified.begin() + 100, { 0xDE, 0xAD, 0xBE, 0xEF });
+
+    std::set<Chunker::Digest> digests;
+    for (const auto &chunk : chunkData(data, data.size()))
+        digests.insert(chunk.digest);
+
+    const auto modifiedChunks = chunkData(modified, modified.size());
+    size_t sharedChunks = 0;
+    for (const auto &chunk : modifiedChunks) {
+        if (digests.contains(chunk.digest))
+            sharedChunks += 1;
+    }
+
+    TEST_ASSERT(sharedChunks + 2 >= modifiedChunks.size());
+
+    TEST_SUCCESS();
+};
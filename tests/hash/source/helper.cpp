@@ -0,0 +1,26 @@
+#include <helper.hpp>
+
+#include <random>
+
+std::vector<wolv::u8> randomBytes(size_t size, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<wolv::u32> distribution(0x00, 0xFF);
+
+    std::vector<wolv::u8> data(size);
+    for (auto &byte : data)
+        byte = distribution(generator);
+
+    return data;
+}
+
+std::string toHex(std::span<const wolv::u8> bytes) {
+    constexpr static auto Digits = "0123456789abcdef";
+
+    std::string result;
+    for (auto byte : bytes) {
+        result += Digits[byte >> 4];
+        result += Digits[byte & 0x0F];
+    }
+
+    return result;
+}
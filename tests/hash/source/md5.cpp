@@ -0,0 +1,38 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/hash/md5.hpp>
+
+#include <helper.hpp>
+
+#include <string>
+
+using namespace std::literals::string_literals;
+
+namespace {
+
+    std::string md5(const std::string &input) {
+        wolv::hash::Md5 md5;
+        md5.process(std::span(reinterpret_cast<const wolv::u8*>(input.data()), input.size()));
+
+        return toHex(md5.getResult());
+    }
+
+}
+
+TEST_SEQUENCE("MD5") {
+    TEST_ASSERT(md5("") == "d41d8cd98f00b204e9800998ecf8427e");
+    TEST_ASSERT(md5("abc") == "900150983cd24fb0d6963f7d28e17f72");
+    TEST_ASSERT(md5("12345678901234567890123456789012345678901234567890123456789012345678901234567890") == "57edf4a22be3c955ac49da2e2107b67a");
+
+    // Feed the same input in differently sized chunks to exercise the block buffering
+    const std::string input(1000, 'a');
+    for (size_t chunkSize : { 1, 3, 63, 64, 65, 1000 }) {
+        wolv::hash::Md5 chunked;
+        for (size_t offset = 0; offset < input.size(); offset += chunkSize)
+            chunked.process(std::span(reinterpret_cast<const wolv::u8*>(input.data()) + offset, std::min(chunkSize, input.size() - offset)));
+
+        TEST_ASSERT(toHex(chunked.getResult()) == "cabe45dcc9ae5b66ba86600cca6b8ba8");
+    }
+
+    TEST_SUCCESS();
+};
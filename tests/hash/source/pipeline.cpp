@@ -0,0 +1,147 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/hash/pipeline.hpp>
+#include <wolv/hash/crc.hpp>
+#include <wolv/hash/md5.hpp>
+#include <wolv/hash/sha256.hpp>
+
+#include <helper.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    struct MemorySource {
+        std::span<const wolv::u8> data;
+        size_t reads = 0;
+
+        wolv::i64 readBufferAtomic(wolv::u64 address, wolv::u8 *buffer, size_t size) {
+            this->reads += 1;
+
+            size = std::min<size_t>(size, this->data.size() - address);
+            std::memcpy(buffer, this->data.data() + address, size);
+            return wolv::i64(size);
+        }
+
+        [[nodiscard]] size_t getSize() const {
+            return this->data.size();
+        }
+    };
+
+    struct MappedSource {
+        std::span<const wolv::u8> data;
+
+        [[nodiscard]] const wolv::u8* getMapping() const {
+            return this->data.data();
+        }
+
+        wolv::i64 readBufferAtomic(wolv::u64, wolv::u8 *, size_t) {
+            return -1;
+        }
+
+        [[nodiscard]] size_t getSize() const {
+            return this->data.size();
+        }
+    };
+
+    struct ExpectedResults {
+        wolv::u64 crc32;
+        wolv::hash::Md5::Digest md5;
+        wolv::hash::Sha256::Digest sha256;
+    };
+
+    wolv::hash::Crc<32> createCrc32() {
+        return { 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true };
+    }
+
+    ExpectedResults computeExpected(std::span<const wolv::u8> data) {
+        auto crc32 = createCrc32();
+        wolv::hash::Md5 md5;
+        wolv::hash::Sha256 sha256;
+
+        crc32.process(data);
+        md5.process(data);
+        sha256.process(data);
+
+        return { crc32.getResult(), md5.getResult(), sha256.getResult() };
+    }
+
+    int checkSource(auto &source, std::span<const wolv::u8> data, wolv::util::ThreadPool *pool) {
+        const auto expected = computeExpected(data);
+
+        auto crc32 = createCrc32();
+        wolv::hash::Md5 md5;
+        wolv::hash::Sha256 sha256;
+
+        if (pool == nullptr)
+            TEST_ASSERT(wolv::hash::hashFile(source, crc32, md5, sha256));
+        else
+            TEST_ASSERT(wolv::hash::hashFile(*pool, source, crc32, md5, sha256));
+
+        TEST_ASSERT(crc32.getResult() == expected.crc32);
+        TEST_ASSERT(md5.getResult() == expected.md5);
+        TEST_ASSERT(sha256.getResult() == expected.sha256);
+
+        TEST_SUCCESS();
+    }
+
+}
+
+TEST_SEQUENCE("Pipeline") {
+    const auto data = randomBytes(wolv::hash::PipelineChunkSize * 3 + 1234, 1);
+
+    MemorySource memorySource = { data };
+    TEST_ASSERT(checkSource(memorySource, data, nullptr) == EXIT_SUCCESS);
+
+    // Every chunk only gets read once, no matter how many hashers there are
+    TEST_ASSERT(memorySource.reads == 4);
+
+    MappedSource mappedSource = { data };
+    TEST_ASSERT(checkSource(mappedSource, data, nullptr) == EXIT_SUCCESS);
+
+    // Hashing a sub range
+    auto sha256 = wolv::hash::Sha256();
+    TEST_ASSERT(wolv::hash::hashRange(memorySource, 100, 1000, sha256));
+
+    wolv::hash::Sha256 expected;
+    expected.process(std::span(data).subspan(100, 1000));
+    TEST_ASSERT(sha256.getResult() == expected.getResult());
+
+    // Reading past the end of the source fails
+    TEST_ASSERT(!wolv::hash::hashRange(memorySource, data.size() - 10, 20, sha256));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Pipeline_ThreadPool") {
+    const auto data = randomBytes(wolv::hash::PipelineChunkSize * 3 + 1234, 2);
+    wolv::util::ThreadPool pool(3);
+
+    MemorySource memorySource = { data };
+    TEST_ASSERT(checkSource(memorySource, data, &pool) == EXIT_SUCCESS);
+    TEST_ASSERT(memorySource.reads == 4);
+
+    MappedSource mappedSource = { data };
+    TEST_ASSERT(checkSource(mappedSource, data, &pool) == EXIT_SUCCESS);
+
+    MemorySource emptySource = { };
+    TEST_ASSERT(checkSource(emptySource, { }, &pool) == EXIT_SUCCESS);
+
+    // Pools that can't run the hashers while the caller waits fall back to hashing on the calling thread
+    wolv::util::ThreadPool emptyPool(0);
+    TEST_ASSERT(checkSource(memorySource, data, &emptyPool) == EXIT_SUCCESS);
+    TEST_ASSERT(checkSource(mappedSource, data, &emptyPool) == EXIT_SUCCESS);
+
+    wolv::util::ThreadPool singlePool(1);
+    std::atomic<int> workerResult = EXIT_FAILURE;
+    singlePool.enqueue([&](const auto &) {
+        workerResult = checkSource(memorySource, data, &singlePool);
+    });
+    singlePool.stop();
+    TEST_ASSERT(workerResult.load() == EXIT_SUCCESS);
+    TEST_ASSERT(checkSource(mappedSource, data, &singlePool) == EXIT_SUCCESS);
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,61 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/hash/rolling_hash.hpp>
+
+#include <helper.hpp>
+
+#include <vector>
+
+namespace {
+
+    template<typename Hash>
+    int testRolling() {
+        constexpr size_t WindowSize = 48;
+        const auto data = randomBytes(1024, 69);
+
+        Hash rolling(WindowSize);
+        rolling.process(std::span(data).first(WindowSize));
+
+        for (size_t i = WindowSize; i < data.size(); i++) {
+            rolling.roll(data[i - WindowSize], data[i]);
+
+            // Rolling the window must give the same result as hashing the window from scratch
+            Hash fresh(WindowSize);
+            fresh.process(std::span(data).subspan(i - WindowSize + 1, WindowSize));
+            TEST_ASSERT(rolling.getResult() == fresh.getResult());
+        }
+
+        TEST_SUCCESS();
+    }
+
+}
+
+TEST_SEQUENCE("RollingHash_RabinKarp") {
+    TEST_ASSERT(testRolling<wolv::hash::RabinKarp>() == EXIT_SUCCESS);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("RollingHash_Buzhash") {
+    TEST_ASSERT(testRolling<wolv::hash::Buzhash>() == EXIT_SUCCESS);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("RollingHash_Gear") {
+    auto first = randomBytes(200, 1);
+    auto second = randomBytes(200, 2);
+
+    // The gear hash only depends on the last 64 bytes
+    std::copy(first.end() - 64, first.end(), second.end() - 64);
+
+    wolv::hash::GearHash firstHash, secondHash;
+    firstHash.process(first);
+    secondHash.process(second);
+    TEST_ASSERT(firstHash.getResult() == secondHash.getResult());
+
+    secondHash.append(0x00);
+    TEST_ASSERT(firstHash.getResult() != secondHash.getResult());
+
+    TEST_SUCCESS();
+};
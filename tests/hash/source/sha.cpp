@@ -0,0 +1,77 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/hash/sha1.hpp>
+#include <wolv/hash/sha256.hpp>
+
+#include <helper.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std::literals::string_literals;
+
+namespace {
+
+    template<typename Digest>
+    std::string digest(const std::string &input, size_t chunkSize = 0) {
+        if (chunkSize == 0)
+            chunkSize = std::max<size_t>(input.size(), 1);
+
+        Digest hasher;
+        for (size_t offset = 0; offset < input.size(); offset += chunkSize)
+            hasher.process(std::span(reinterpret_cast<const wolv::u8*>(input.data()) + offset, std::min(chunkSize, input.size() - offset)));
+
+        return toHex(hasher.getResult());
+    }
+
+}
+
+TEST_SEQUENCE("SHA1") {
+    using wolv::hash::Sha1;
+
+    TEST_ASSERT(digest<Sha1>("") == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    TEST_ASSERT(digest<Sha1>("abc") == "a9993e364706816aba3e25717850c26c9cd0d89d");
+    TEST_ASSERT(digest<Sha1>("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") == "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+
+    const std::string input(1000, 'a');
+    for (size_t chunkSize : { 1, 3, 63, 64, 65, 1000 })
+        TEST_ASSERT(digest<Sha1>(input, chunkSize) == "291e9a6c66994949b57ba5e650361e98fc36b1ba");
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("SHA256") {
+    using wolv::hash::Sha256;
+
+    TEST_ASSERT(digest<Sha256>("") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    TEST_ASSERT(digest<Sha256>("abc") == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    TEST_ASSERT(digest<Sha256>("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    const std::string input(1000, 'a');
+    for (size_t chunkSize : { 1, 3, 63, 64, 65, 1000 })
+        TEST_ASSERT(digest<Sha256>(input, chunkSize) == "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3");
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("SHA_Accelerated") {
+    #if defined(WOLV_HASH_ARCH_X86)
+        const auto &features = wolv::hash::detail::getCpuFeatures();
+        if (!(features.sha && features.ssse3 && features.sse41))
+            TEST_SUCCESS();
+
+        const auto data = randomBytes(33 * 64, 1337);
+
+        auto sha1Portable = wolv::hash::Sha1::InitialState, sha1Accelerated = sha1Portable;
+        wolv::hash::detail::sha1CompressPortable(sha1Portable, data.data(), data.size() / 64);
+        wolv::hash::detail::sha1CompressShaNi(sha1Accelerated, data.data(), data.size() / 64);
+        TEST_ASSERT(sha1Portable == sha1Accelerated);
+
+        auto sha256Portable = wolv::hash::Sha256::InitialState, sha256Accelerated = sha256Portable;
+        wolv::hash::detail::sha256CompressPortable(sha256Portable, data.data(), data.size() / 64);
+        wolv::hash::detail::sha256CompressShaNi(sha256Accelerated, data.data(), data.size() / 64);
+        TEST_ASSERT(sha256Portable == sha256Accelerated);
+    #endif
+
+    TEST_SUCCESS();
+};
@@ -1,5 +1,7 @@
 
 #include <regex>
+#include <set>
+#include <vector>
 
 #include <wolv/test/tests.hpp>
 
@@ -18,3 +20,65 @@ TEST_SEQUENCE("UUID") {
 
     TEST_SUCCESS();
 };
+
+TEST_SEQUENCE("UUID_V4") {
+    using wolv::hash::Uuid;
+
+    std::set<Uuid> uuids;
+    for (size_t i = 0; i < 1000; i++) {
+        const auto uuid = Uuid::generateV4();
+        TEST_ASSERT(uuid.getVersion() == 4);
+        TEST_ASSERT((uuid.bytes[8] & 0xC0) == 0x80);
+
+        uuids.insert(uuid);
+    }
+
+    TEST_ASSERT(uuids.size() == 1000);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("UUID_V7") {
+    using wolv::hash::Uuid;
+
+    std::vector<Uuid> uuids(10000);
+    Uuid::generate(uuids, Uuid::Version::TimeOrdered);
+    uuids.push_back(Uuid::generateV7());
+
+    for (size_t i = 0; i < uuids.size(); i++) {
+        TEST_ASSERT(uuids[i].getVersion() == 7);
+        TEST_ASSERT((uuids[i].bytes[8] & 0xC0) == 0x80);
+
+        // UUIDs generated on the same thread need to be strictly increasing
+        if (i > 0)
+            TEST_ASSERT(uuids[i - 1] < uuids[i]);
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("UUID_Parse") {
+    using wolv::hash::Uuid;
+
+    const auto uuid = Uuid::parse("123e4567-E89B-12d3-a456-426614174000");
+    TEST_ASSERT(uuid.has_value());
+    TEST_ASSERT(uuid->bytes[0] == 0x12 && uuid->bytes[5] == 0x9B && uuid->bytes[15] == 0x00);
+    TEST_ASSERT(uuid->getVersion() == 1);
+    TEST_ASSERT(uuid->toString() == "123e4567-e89b-12d3-a456-426614174000");
+    TEST_ASSERT(Uuid::parse("123e4567e89b12d3a456426614174000") == uuid);
+
+    TEST_ASSERT(!Uuid::parse("123e4567-e89b-12d3-a456-42661417400").has_value());
+    TEST_ASSERT(!Uuid::parse("123e4567-e89b-12d3-a456_426614174000").has_value());
+    TEST_ASSERT(!Uuid::parse("123e4567-e89b-12d3-a456-42661417400g").has_value());
+    TEST_ASSERT(!Uuid::parse("123e4567-e89b-12d3-a456-4266141740:0").has_value());
+
+    for (size_t i = 0; i < 100; i++) {
+        const auto generated = Uuid::generateV4();
+        TEST_ASSERT(Uuid::parse(generated.toString()) == generated);
+    }
+
+    TEST_ASSERT(Uuid{}.isNil());
+    TEST_ASSERT(Uuid{}.toString() == "00000000-0000-0000-0000-000000000000");
+
+    TEST_SUCCESS();
+};
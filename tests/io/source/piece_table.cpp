@@ -0,0 +1,161 @@
+#include <wolv/test/tests.hpp>
+#include <wolv/types.hpp>
+#include <wolv/io/file.hpp>
+#include <wolv/io/piece_table.hpp>
+
+#include <helper.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace wolv::unsigned_integers;
+
+namespace {
+
+    std::span<const u8> bytes(const std::string &string) {
+        return { reinterpret_cast<const u8*>(string.data()), string.size() };
+    }
+
+    std::string toString(const std::vector<u8> &data) {
+        return { data.begin(), data.end() };
+    }
+
+}
+
+TEST_SEQUENCE("PieceTable_Basic") {
+    const std::string base = "Hello World";
+    wolv::io::PieceTable table(bytes(base));
+
+    TEST_ASSERT(table.size() == base.size());
+    TEST_ASSERT(table.getPieceCount() == 1);
+    TEST_ASSERT(toString(table.read(0, table.size())) == base);
+
+    table.insert(5, bytes(","));
+    table.insert(7, bytes("Big"));
+    TEST_ASSERT(toString(table.read(0, table.size())) == "Hello, BigWorld");
+
+    // Appending right behind the previous insert extends its piece
+    const auto pieceCount = table.getPieceCount();
+    table.insert(10, bytes("ger "));
+    TEST_ASSERT(table.getPieceCount() == pieceCount);
+    TEST_ASSERT(toString(table.read(0, table.size())) == "Hello, Bigger World");
+
+    table.erase(5, 9);
+    TEST_ASSERT(toString(table.read(0, table.size())) == "HelloWorld");
+
+    table.insert(5, bytes(", "));
+    table.write(7, bytes("w"));
+    TEST_ASSERT(toString(table.read(0, table.size())) == "Hello, world");
+
+    table.insert(table.size(), bytes("!"));
+    table.erase(0, 7);
+    TEST_ASSERT(toString(table.read(0, table.size())) == "world!");
+
+    // Reads past the end are cut short, erases past the end stop at the end
+    TEST_ASSERT(toString(table.read(3, 100)) == "ld!");
+    table.erase(4, 100);
+    TEST_ASSERT(toString(table.read(0, table.size())) == "worl");
+
+    wolv::io::PieceTableReader reader(&table, table.size());
+    TEST_ASSERT(toString(reader.read(1, 3)) == "orl");
+
+    table.reset();
+    TEST_ASSERT(toString(table.read(0, table.size())) == base);
+
+    // File backed piece tables read the base through the file and can write the result to another file
+    const auto basePath = std::fs::current_path() / randomFilename();
+    const auto savePath = std::fs::current_path() / randomFilename();
+    ON_SCOPE_EXIT { std::fs::remove(basePath); std::fs::remove(savePath); };
+
+    {
+        wolv::io::File file(basePath, wolv::io::File::Mode::Create);
+        TEST_ASSERT(file.isValid());
+        file.writeString(base);
+    }
+
+    wolv::io::File file(basePath, wolv::io::File::Mode::Read);
+    TEST_ASSERT(file.isValid());
+
+    wolv::io::PieceTable fileTable(file);
+    fileTable.insert(0, bytes(">> "));
+    fileTable.erase(7, 1);
+
+    {
+        wolv::io::File saveFile(savePath, wolv::io::File::Mode::Create);
+        TEST_ASSERT(fileTable.save(saveFile));
+    }
+
+    wolv::io::File saveFile(savePath, wolv::io::File::Mode::Read);
+    TEST_ASSERT(saveFile.readString() == ">> Hell World");
+
+    // Reads stop at base bytes that can't be read anymore, saving fails instead of writing garbage
+    std::fs::resize_file(basePath, 4);
+    TEST_ASSERT(toString(fileTable.read(0, fileTable.size())) == ">> Hell");
+
+    {
+        wolv::io::File truncatedSaveFile(savePath, wolv::io::File::Mode::Create);
+        TEST_ASSERT(!fileTable.save(truncatedSaveFile));
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("PieceTable_Random") {
+    std::mt19937 random(1337);
+
+    std::vector<u8> base(0x10000);
+    for (auto &byte : base)
+        byte = u8(random());
+
+    wolv::io::PieceTable table(base);
+    std::vector<u8> expected = base;
+
+    for (u32 step = 0; step < 5000; step += 1) {
+        const auto offset = u64(random() % (expected.size() + 1));
+
+        switch (random() % 3) {
+            case 0: {
+                std::vector<u8> data(random() % 64 + 1);
+                for (auto &byte : data)
+                    byte = u8(random());
+
+                table.insert(offset, data);
+                expected.insert(expected.begin() + offset, data.begin(), data.end());
+                break;
+            }
+            case 1: {
+                const auto size = std::min<u64>(random() % 64, expected.size() - offset);
+
+                table.erase(offset, size);
+                expected.erase(expected.begin() + offset, expected.begin() + offset + size);
+                break;
+            }
+            case 2: {
+                std::vector<u8> data(random() % 16 + 1);
+                for (auto &byte : data)
+                    byte = u8(random());
+
+                table.write(offset, data);
+                if (offset + data.size() > expected.size())
+                    expected.resize(offset + data.size());
+                std::copy(data.begin(), data.end(), expected.begin() + offset);
+                break;
+            }
+        }
+
+        TEST_ASSERT(table.size() == expected.size());
+
+        if (step % 100 == 0) {
+            TEST_ASSERT(table.read(0, table.size()) == expected);
+        }
+
+        const auto readOffset = u64(random() % (expected.size() + 1));
+        const auto readSize = std::min<u64>(random() % 256, expected.size() - readOffset);
+        TEST_ASSERT(table.read(readOffset, readSize) == std::vector<u8>(expected.begin() + readOffset, expected.begin() + readOffset + readSize));
+    }
+
+    TEST_ASSERT(table.read(0, table.size()) == expected);
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,157 @@
+#include <wolv/test/tests.hpp>
+
+#include <wolv/utils/memory_resource.hpp>
+#include <wolv/utils/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace wolv::util;
+using namespace wolv::unsigned_integers;
+
+namespace {
+
+    // Upstream resource that counts how often it gets asked for memory
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocations = 0, deallocations = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            this->allocations += 1;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override {
+            this->deallocations += 1;
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+}
+
+TEST_SEQUENCE("MonotonicArena") {
+    CountingResource upstream;
+
+    {
+        MonotonicArena arena(0x1000, &upstream);
+
+        for (u32 frame = 0; frame < 10; frame += 1) {
+            std::pmr::vector<std::pmr::string> strings(&arena);
+            for (u32 i = 0; i < 1000; i += 1)
+                strings.emplace_back("a string that is too long for the small string optimization");
+
+            TEST_ASSERT(strings.back().size() > 32);
+            TEST_ASSERT(arena.getBytesUsed() > 0);
+
+            arena.reset();
+            TEST_ASSERT(arena.getBytesUsed() == 0);
+        }
+
+        // After the first frame, all memory comes from the chunks that have been kept around
+        const auto allocations = upstream.allocations;
+        {
+            std::pmr::vector<std::pmr::string> strings(&arena);
+            for (u32 i = 0; i < 1000; i += 1)
+                strings.emplace_back("a string that is too long for the small string optimization");
+        }
+        TEST_ASSERT(upstream.allocations == allocations);
+        TEST_ASSERT(upstream.deallocations == 0);
+
+        // Large and overaligned requests
+        auto large = arena.allocate(0x100000, 64);
+        const auto largeMisalignment = reinterpret_cast<std::uintptr_t>(large) % 64;
+        TEST_ASSERT(largeMisalignment == 0);
+        TEST_ASSERT(arena.getBytesReserved() >= 0x100000);
+    }
+
+    TEST_ASSERT(upstream.allocations == upstream.deallocations);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("PoolResource") {
+    CountingResource upstream;
+
+    {
+        PoolResource pool(&upstream);
+
+        std::vector<void*> blocks;
+        for (u32 i = 0; i < 1000; i += 1) {
+            const auto size = size_t(1) << (i % 10);
+            auto block = pool.allocate(size, std::min<size_t>(size, alignof(std::max_align_t)));
+            const auto misalignment = reinterpret_cast<std::uintptr_t>(block) % std::min<size_t>(size, alignof(std::max_align_t));
+            TEST_ASSERT(misalignment == 0);
+            std::memset(block, 0xAA, size);
+            blocks.push_back(block);
+        }
+
+        for (u32 i = 0; i < blocks.size(); i += 1) {
+            const auto size = size_t(1) << (i % 10);
+            pool.deallocate(blocks[i], size, std::min<size_t>(size, alignof(std::max_align_t)));
+        }
+
+        // Freed blocks are reused without going back to upstream
+        const auto allocations = upstream.allocations;
+        {
+            std::pmr::list<u64> list(&pool);
+            for (u32 i = 0; i < 50; i += 1)
+                list.push_back(i);
+        }
+        TEST_ASSERT(upstream.allocations == allocations);
+
+        // Large blocks are forwarded to upstream
+        auto large = pool.allocate(PoolResource::MaxBlockSize * 2);
+        TEST_ASSERT(upstream.allocations == allocations + 1);
+        pool.deallocate(large, PoolResource::MaxBlockSize * 2);
+
+        // The task queue of a thread pool only uses its resource while holding its lock
+        {
+            ThreadPool threadPool(2, &pool);
+
+            std::atomic<u32> counter = 0;
+            for (u32 i = 0; i < 100; i += 1)
+                threadPool.enqueue([&counter](const auto &) { counter += 1; });
+
+            threadPool.stop();
+            TEST_ASSERT(counter.load() == 100);
+        }
+    }
+
+    TEST_ASSERT(upstream.allocations == upstream.deallocations);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("ThreadPool_MoveResource") {
+    CountingResource first, second;
+
+    {
+        // Without worker threads, enqueued tasks stay in the queue and show which resource it allocates from
+        ThreadPool pool(0, &first);
+        pool.enqueue([](const auto &) { });
+
+        ThreadPool moved(std::move(pool));
+        moved.enqueue([](const auto &) { });
+        TEST_ASSERT(first.allocations == 2);
+
+        ThreadPool assigned(0, &second);
+        assigned = std::move(moved);
+        assigned.enqueue([](const auto &) { });
+        TEST_ASSERT(first.allocations == 3);
+        TEST_ASSERT(second.allocations == 0);
+    }
+
+    TEST_ASSERT(first.allocations == first.deallocations);
+
+    TEST_SUCCESS();
+};